@@ -10,3 +10,31 @@ USE_FPU=y
 
 USE_LPCOPEN=y
 USE_SAPI=y
+
+# Driver options
+
+# Switch the keyboard to scan code set 3 at startup (falls back to set 2)
+#DEFINES+=PS2_USE_SCAN_SET3
+
+# Keyboard layout for PS2Keyboard_KeyToChar() (default US)
+#DEFINES+=PS2_LAYOUT_LATAM
+
+# Daisy-chained MAX7219 panels on the display chip select (default 1)
+#DEFINES+=MAX7219_PANELS=4
+
+# Send display updates by DMA, the CPU does not wait for the SPI bus
+#DEFINES+=MAX7219_USE_DMA
+
+# Grayscale led matrix (MatrixGrayStart), 2 or 3 bit planes refreshed by TIMER1. Needs MAX7219_USE_DMA
+#DEFINES+=MATRIX_GRAY_PLANES=3
+
+# Debug options
+
+# Replace the SPI DMA by a model completing transfers after their bus time
+#DEFINES+=SPI_DMA_SIM
+
+# Decode the display SPI traffic, statistics printed when leaving encryption mode
+#DEFINES+=MAX7219_TRACE
+
+# Time the PS/2 clock ISR entries, LED3 high while it runs (scope it against the clock)
+#DEFINES+=PS2_LATENCY_PROBE
@@ -30,6 +30,8 @@
 
      Two byte Codes preceded by E0 code returned as keycodes
 
+     Scan code set 3 codes that differ from set 2 (PS2_KC3_*)
+
   This library is free software; you can redistribute it and/or
   modify it under the terms of the GNU Lesser General Public
   License as published by the Free Software Foundation; either
@@ -52,12 +54,27 @@
 #define PS2_KEY_IGNORE  0xBB
 
 //  buffer sizes keyboard RX and TX, then key reading buffer
+//  all are ring_buffer queues so sizes MUST be powers of two
 // Minimum size 8 can be larger
 #define _RX_BUFFER_SIZE  8
-// Minimum size 6 can be larger
-#define _TX_BUFFER_SIZE  6
+// Minimum size 6 can be larger, queued commands are pipelined into it while they fit
+#define _TX_BUFFER_SIZE  16
 // Output Buffer of unsigned int values. Minimum size 4 can be larger
 #define _KEY_BUFF_SIZE   4
+// Number of key event handlers that can be subscribed at once
+#define _MAX_HANDLERS    2
+// Keyboard commands waiting or in flight, any size
+#define _CMD_QUEUE_SIZE  8
+// Response bytes kept per command (ACKs included)
+#define _CMD_MAX_RESP    4
+// Default response timeout and retries per command
+#define _CMD_TIMEOUT_MS  50
+#define _CMD_RETRIES     2
+// Reset answers after the keyboard self-test (BAT), up to 750 ms
+#define _CMD_RESET_TIMEOUT_MS 1000
+
+// Max time for one received frame (11 bits at 10 kHz is 1.1 ms)
+#define _FRAME_TIMEOUT_US 2000
 
 /* private defines for library files not global */
 /* _ps2mode status flags */
@@ -110,6 +127,8 @@
 #define PS2_KC_READID   0xF2
 #define PS2_KC_SCANCODE 0xF0
 #define PS2_KC_LOCK     0xED
+/* Scan code set 3 only, make AND break codes for every key (no typematic) */
+#define PS2_KC_ALL_MKBRK 0xF8
 
 /* Single Byte Key Codes */
 #define PS2_KC_NUM      0x77
@@ -273,4 +292,50 @@
 #define PS2_KC_POWER    0X37
 #define PS2_KC_SLEEP    0X3F
 #define PS2_KC_WAKE     0X5E
+
+/* Scan code set 3, every key is a single byte, break is F0 + code.
+   Letters, digits, main punctuation, BS, TAB, ENTER, SPACE, both SHIFTs
+   and keypad digits/dot use the same codes as set 2 above */
+#define PS2_KC3_ESC      0x08
+#define PS2_KC3_F1       0x07
+#define PS2_KC3_F2       0x0F
+#define PS2_KC3_F3       0x17
+#define PS2_KC3_F4       0x1F
+#define PS2_KC3_F5       0x27
+#define PS2_KC3_F6       0x2F
+#define PS2_KC3_F7       0x37
+#define PS2_KC3_F8       0x3F
+#define PS2_KC3_F9       0x47
+#define PS2_KC3_F10      0x4F
+#define PS2_KC3_F11      0x56
+#define PS2_KC3_F12      0x5E
+#define PS2_KC3_PRTSCR   0x57
+#define PS2_KC3_SCROLL   0x5F
+#define PS2_KC3_PAUSE    0x62
+#define PS2_KC3_CAPS     0x14
+#define PS2_KC3_L_CTRL   0x11
+#define PS2_KC3_R_CTRL   0x58
+#define PS2_KC3_L_ALT    0x19
+#define PS2_KC3_R_ALT    0x39
+#define PS2_KC3_L_GUI    0x8B
+#define PS2_KC3_R_GUI    0x8C
+#define PS2_KC3_MENU     0x8D
+#define PS2_KC3_BACK     0x5C
+#define PS2_KC3_EUROPE2  0x13
+#define PS2_KC3_INSERT   0x67
+#define PS2_KC3_HOME     0x6E
+#define PS2_KC3_PGUP     0x6F
+#define PS2_KC3_DELETE   0x64
+#define PS2_KC3_END      0x65
+#define PS2_KC3_PGDN     0x6D
+#define PS2_KC3_UP_ARROW 0x63
+#define PS2_KC3_L_ARROW  0x61
+#define PS2_KC3_DN_ARROW 0x60
+#define PS2_KC3_R_ARROW  0x6A
+#define PS2_KC3_NUM      0x76
+#define PS2_KC3_KP_DIV   0x77
+#define PS2_KC3_KP_TIMES 0x7E
+#define PS2_KC3_KP_MINUS 0x84
+#define PS2_KC3_KP_PLUS  0x7C
+#define PS2_KC3_KP_ENTER 0x79
 #endif
@@ -0,0 +1,178 @@
+/*
+  PS2KeyLayout.h - PS2Keyboard library key code to character tables
+
+  PRIVATE to library
+
+  Maps the key codes returned by the library (see PS2Keyboard.h) to
+  characters for ONE keyboard layout selected at build time, so only that
+  layout is linked in and PS2Keyboard_KeyToChar() is a single table load.
+
+  Select the layout in config.mk, default is US
+     DEFINES+=PS2_LAYOUT_LATAM    Latin American Spanish
+
+  Each layout is one list of entries expanded by the preprocessor into
+  the final tables, one per modifier state
+
+     KEY( code, plain, shifted )      same character with CAPS lock
+     LETTER( code, lower, upper )     CAPS lock swaps the case
+     ALTGR( code, char )              character with ALT GR
+
+  Characters are ISO-8859-1 (Latin-1) so accented letters and symbols fit
+  one byte, 0 means no character for that key and state.
+
+  Adding a layout is adding its list plus the #elif selecting it.
+*/
+#ifndef PS2KeyLayout_h
+#define PS2KeyLayout_h
+
+/* Keys valid in every layout */
+#define PS2_LAYOUT_COMMON( KEY ) \
+                KEY( PS2_KEY_ESC, 0x1B, 0x1B ) \
+                KEY( PS2_KEY_BS, 0x08, 0x08 ) \
+                KEY( PS2_KEY_TAB, '\t', '\t' ) \
+                KEY( PS2_KEY_ENTER, '\n', '\n' ) \
+                KEY( PS2_KEY_SPACE, ' ', ' ' ) \
+                KEY( PS2_KEY_KP0, '0', '0' ) \
+                KEY( PS2_KEY_KP1, '1', '1' ) \
+                KEY( PS2_KEY_KP2, '2', '2' ) \
+                KEY( PS2_KEY_KP3, '3', '3' ) \
+                KEY( PS2_KEY_KP4, '4', '4' ) \
+                KEY( PS2_KEY_KP5, '5', '5' ) \
+                KEY( PS2_KEY_KP6, '6', '6' ) \
+                KEY( PS2_KEY_KP7, '7', '7' ) \
+                KEY( PS2_KEY_KP8, '8', '8' ) \
+                KEY( PS2_KEY_KP9, '9', '9' ) \
+                KEY( PS2_KEY_KP_DOT, '.', '.' ) \
+                KEY( PS2_KEY_KP_ENTER, '\n', '\n' ) \
+                KEY( PS2_KEY_KP_PLUS, '+', '+' ) \
+                KEY( PS2_KEY_KP_MINUS, '-', '-' ) \
+                KEY( PS2_KEY_KP_TIMES, '*', '*' ) \
+                KEY( PS2_KEY_KP_DIV, '/', '/' ) \
+                KEY( PS2_KEY_KP_EQUAL, '=', '=' ) \
+                KEY( PS2_KEY_KP_COMMA, ',', ',' )
+
+/* Latin letters, same position in both layouts */
+#define PS2_LAYOUT_LETTERS( LETTER ) \
+                LETTER( PS2_KEY_A, 'a', 'A' ) \
+                LETTER( PS2_KEY_B, 'b', 'B' ) \
+                LETTER( PS2_KEY_C, 'c', 'C' ) \
+                LETTER( PS2_KEY_D, 'd', 'D' ) \
+                LETTER( PS2_KEY_E, 'e', 'E' ) \
+                LETTER( PS2_KEY_F, 'f', 'F' ) \
+                LETTER( PS2_KEY_G, 'g', 'G' ) \
+                LETTER( PS2_KEY_H, 'h', 'H' ) \
+                LETTER( PS2_KEY_I, 'i', 'I' ) \
+                LETTER( PS2_KEY_J, 'j', 'J' ) \
+                LETTER( PS2_KEY_K, 'k', 'K' ) \
+                LETTER( PS2_KEY_L, 'l', 'L' ) \
+                LETTER( PS2_KEY_M, 'm', 'M' ) \
+                LETTER( PS2_KEY_N, 'n', 'N' ) \
+                LETTER( PS2_KEY_O, 'o', 'O' ) \
+                LETTER( PS2_KEY_P, 'p', 'P' ) \
+                LETTER( PS2_KEY_Q, 'q', 'Q' ) \
+                LETTER( PS2_KEY_R, 'r', 'R' ) \
+                LETTER( PS2_KEY_S, 's', 'S' ) \
+                LETTER( PS2_KEY_T, 't', 'T' ) \
+                LETTER( PS2_KEY_U, 'u', 'U' ) \
+                LETTER( PS2_KEY_V, 'v', 'V' ) \
+                LETTER( PS2_KEY_W, 'w', 'W' ) \
+                LETTER( PS2_KEY_X, 'x', 'X' ) \
+                LETTER( PS2_KEY_Y, 'y', 'Y' ) \
+                LETTER( PS2_KEY_Z, 'z', 'Z' )
+
+#if defined( PS2_LAYOUT_LATAM )
+/* Latin American Spanish, dead keys return their accent */
+#define PS2_LAYOUT_KEYS( KEY, LETTER, ALTGR ) \
+                PS2_LAYOUT_COMMON( KEY ) \
+                PS2_LAYOUT_LETTERS( LETTER ) \
+                LETTER( PS2_KEY_SEMI, 0xF1, 0xD1 )  /* n tilde */ \
+                KEY( PS2_KEY_0, '0', '=' ) \
+                KEY( PS2_KEY_1, '1', '!' ) \
+                KEY( PS2_KEY_2, '2', '"' ) \
+                KEY( PS2_KEY_3, '3', '#' ) \
+                KEY( PS2_KEY_4, '4', '$' ) \
+                KEY( PS2_KEY_5, '5', '%' ) \
+                KEY( PS2_KEY_6, '6', '&' ) \
+                KEY( PS2_KEY_7, '7', '/' ) \
+                KEY( PS2_KEY_8, '8', '(' ) \
+                KEY( PS2_KEY_9, '9', ')' ) \
+                KEY( PS2_KEY_SINGLE, '|', 0xB0 )    /* degree */ \
+                KEY( PS2_KEY_MINUS, '\'', '?' ) \
+                KEY( PS2_KEY_EQUAL, 0xBF, 0xA1 )    /* inverted ? and ! */ \
+                KEY( PS2_KEY_OPEN_SQ, 0xB4, 0xA8 )  /* acute, diaeresis */ \
+                KEY( PS2_KEY_CLOSE_SQ, '+', '*' ) \
+                KEY( PS2_KEY_APOS, '{', '[' ) \
+                KEY( PS2_KEY_BACK, '}', ']' ) \
+                KEY( PS2_KEY_COMMA, ',', ';' ) \
+                KEY( PS2_KEY_DOT, '.', ':' ) \
+                KEY( PS2_KEY_DIV, '-', '_' ) \
+                KEY( PS2_KEY_EUROPE2, '<', '>' ) \
+                ALTGR( PS2_KEY_Q, '@' ) \
+                ALTGR( PS2_KEY_SINGLE, 0xAC )       /* not sign */ \
+                ALTGR( PS2_KEY_MINUS, '\\' ) \
+                ALTGR( PS2_KEY_CLOSE_SQ, '~' ) \
+                ALTGR( PS2_KEY_APOS, '^' ) \
+                ALTGR( PS2_KEY_BACK, '`' )
+#else
+/* US */
+#define PS2_LAYOUT_KEYS( KEY, LETTER, ALTGR ) \
+                PS2_LAYOUT_COMMON( KEY ) \
+                PS2_LAYOUT_LETTERS( LETTER ) \
+                KEY( PS2_KEY_0, '0', ')' ) \
+                KEY( PS2_KEY_1, '1', '!' ) \
+                KEY( PS2_KEY_2, '2', '@' ) \
+                KEY( PS2_KEY_3, '3', '#' ) \
+                KEY( PS2_KEY_4, '4', '$' ) \
+                KEY( PS2_KEY_5, '5', '%' ) \
+                KEY( PS2_KEY_6, '6', '^' ) \
+                KEY( PS2_KEY_7, '7', '&' ) \
+                KEY( PS2_KEY_8, '8', '*' ) \
+                KEY( PS2_KEY_9, '9', '(' ) \
+                KEY( PS2_KEY_SINGLE, '`', '~' ) \
+                KEY( PS2_KEY_MINUS, '-', '_' ) \
+                KEY( PS2_KEY_EQUAL, '=', '+' ) \
+                KEY( PS2_KEY_OPEN_SQ, '[', '{' ) \
+                KEY( PS2_KEY_CLOSE_SQ, ']', '}' ) \
+                KEY( PS2_KEY_SEMI, ';', ':' ) \
+                KEY( PS2_KEY_APOS, '\'', '"' ) \
+                KEY( PS2_KEY_BACK, '\\', '|' ) \
+                KEY( PS2_KEY_COMMA, ',', '<' ) \
+                KEY( PS2_KEY_DOT, '.', '>' ) \
+                KEY( PS2_KEY_DIV, '/', '?' ) \
+                KEY( PS2_KEY_EUROPE2, '\\', '|' )
+#endif
+
+/* Table entry generators */
+#define _LAYOUT_FIRST( code, a, b )   [ code ] = ( a ),
+#define _LAYOUT_SECOND( code, a, b )  [ code ] = ( b ),
+#define _LAYOUT_SKIP3( code, a, b )
+#define _LAYOUT_ALTGR( code, a )      [ code ] = ( a ),
+#define _LAYOUT_SKIP2( code, a )
+
+/* Key codes above the last printable key have no character,
+   every row starts with [ 0 ] = 0 so a layout may have no ALT GR keys */
+#define _LAYOUT_SIZE    ( PS2_KEY_EUROPE2 + 1 )
+
+/* Modifier states, see PS2Keyboard_KeyToChar() */
+#define _LAYOUT_SHIFT   1
+#define _LAYOUT_CAPS    2
+#define _LAYOUT_ALT_GR  4
+#define _LAYOUT_STATES  5
+
+#if defined(PS2_REQUIRES_PROGMEM)
+const uint8_t PROGMEM layout_char[ _LAYOUT_STATES ][ _LAYOUT_SIZE ] = {
+#else
+const uint8_t layout_char[ _LAYOUT_STATES ][ _LAYOUT_SIZE ] = {
+#endif
+                /* No modifiers */
+                { [ 0 ] = 0, PS2_LAYOUT_KEYS( _LAYOUT_FIRST, _LAYOUT_FIRST, _LAYOUT_SKIP2 ) },
+                /* SHIFT */
+                { [ 0 ] = 0, PS2_LAYOUT_KEYS( _LAYOUT_SECOND, _LAYOUT_SECOND, _LAYOUT_SKIP2 ) },
+                /* CAPS lock */
+                { [ 0 ] = 0, PS2_LAYOUT_KEYS( _LAYOUT_FIRST, _LAYOUT_SECOND, _LAYOUT_SKIP2 ) },
+                /* CAPS lock and SHIFT */
+                { [ 0 ] = 0, PS2_LAYOUT_KEYS( _LAYOUT_SECOND, _LAYOUT_FIRST, _LAYOUT_SKIP2 ) },
+                /* ALT GR, other modifiers ignored */
+                { [ 0 ] = 0, PS2_LAYOUT_KEYS( _LAYOUT_SKIP3, _LAYOUT_SKIP3, _LAYOUT_ALTGR ) }
+                };
+#endif
@@ -17,6 +17,9 @@
 	- Adjusted pin handling and register configuration for NXP LPC4337 architecture.
 	- Improved comments for readability
 	- Added functions `PS2Keyboard_EnableInt()` and `PS2Keyboard_DisableInt()` for manual control of PS/2 interrupt handling.
+	- Added `PS2Keyboard_Subscribe()` and `PS2Keyboard_Process()` to deliver key events to handlers instead of polling.
+	- Added health counters (`PS2Keyboard_GetStats()`) for queue overflows, parity errors, resends and timeouts.
+	- Added optional Scan Code Set 3 mode (`PS2Keyboard_UseScanSet3()`), falling back to Set 2.
 
 	### IMPORTANT:
 	This library has been adapted for use with the EDU-CIAA board and the NXP LPC4337 microcontroller.
@@ -96,7 +99,8 @@
 
 	### Related files:
 	- **PS2KeyCode.h** -> Contains original PS/2 keyboard scancodes used by this library.
-	- **PS2KeyTable.h** -> Provides mapping tables for converting scancodes into ASCII/UTF-8 characters.
+	- **PS2KeyTable.h** -> Provides mapping tables for converting scancodes into key codes.
+	- **PS2KeyLayout.h** -> Key code to character tables for the layout selected at build time.
 
    See this file for returned definitions of Keys and accessible definitions.
 
@@ -137,6 +141,56 @@
 // Below is general error code
 #define PS2_KEY_ERROR    0xFC
 
+/* Key event filters for PS2Keyboard_Subscribe, OR together */
+#define PS2_EVENT_MAKE   0x01
+#define PS2_EVENT_BREAK  0x02
+#define PS2_EVENT_ALL    ( PS2_EVENT_MAKE | PS2_EVENT_BREAK )
+
+/* Key event handler, receives the translated key with its status bits */
+typedef void (*ps2KeyHandler_t)(uint16_t key);
+
+/* Keyboard command completion status, see PS2Keyboard_SendCommand */
+#define PS2_CMD_OK        0
+#define PS2_CMD_TIMEOUT  -1     // No complete response after all retries
+#define PS2_CMD_ERROR    -2     // Keyboard answered 0xFC after all retries
+#define PS2_CMD_MAX_BYTES 4     // Command plus data bytes per command
+
+/* Keyboard command completion callback, resp holds every response byte (ACKs included) */
+typedef void (*ps2CmdCallback_t)(int8_t status, const uint8_t *resp, uint8_t len, void *ctx);
+
+/* Keyboard command descriptor, see PS2Keyboard_SendCommand */
+typedef struct {
+    uint8_t bytes[PS2_CMD_MAX_BYTES]; // Command then data bytes, each is ACKed except ECHO
+    uint8_t len;                      // Number of bytes
+    uint8_t resp_len;                 // Extra bytes after the last ACK (e.g. 2 for READ ID)
+    uint16_t timeout_ms;              // Response timeout, 0 for the default
+    uint8_t retries;                  // Times to send again on timeout or error
+    ps2CmdCallback_t callback;        // Completion callback, NULL to send responses to the key buffer
+    void *ctx;                        // Passed to the callback
+} ps2Command_t;
+
+/* Driver health counters, see PS2Keyboard_GetStats */
+typedef struct {
+    uint16_t rx_overflows;    // Received bytes lost, RX queue full
+    uint16_t tx_overflows;    // Command bytes rejected, TX queue full
+    uint16_t key_stalls;      // Times scan codes waited behind a full key queue
+    uint16_t parity_errors;   // Received frames with bad parity (RESEND sent)
+    uint16_t resend_requests; // RESEND received from the keyboard
+    uint16_t frame_timeouts;  // Frames aborted by the frame timeout
+    uint16_t kbd_overruns;    // Keyboard reported its own buffer overrun
+    uint16_t keys_unhandled;  // Keys of a subscribed event type no handler's modifiers matched
+    uint16_t cmd_retries;     // Keyboard commands sent again
+    uint16_t cmd_failures;    // Keyboard commands given up
+    uint8_t rx_high_water;    // Highest RX queue count seen
+    uint8_t tx_high_water;    // Highest TX queue count seen
+    uint8_t key_high_water;   // Highest key queue count seen
+#if defined(PS2_LATENCY_PROBE)
+    uint16_t clk_min_us;      // Shortest clock period inside a frame
+    uint16_t clk_max_us;      // Longest one, max - min bounds the late ISR entries
+    uint16_t isr_max_cycles;  // Longest clock ISR run
+#endif
+} ps2Stats_t;
+
 /* Command parameters for functions */
 /* LED codes OR together */
 #define PS2_LOCK_SCROLL  0x01
@@ -356,6 +410,90 @@ uint8_t PS2Keyboard_Available(void);
 uint16_t PS2Keyboard_Read(void);
 
 
+/**
+ * @brief Registers a handler for translated key events.
+ *
+ * Handlers are called from PS2Keyboard_Process(), never from the interrupt,
+ * once per translated key that matches the filter. While at least one handler
+ * is registered, keys are delivered to the handlers instead of the buffer
+ * read by PS2Keyboard_Available()/PS2Keyboard_Read().
+ *
+ * @param handler   Function to call with each matching key.
+ * @param events    PS2_EVENT_MAKE, PS2_EVENT_BREAK or PS2_EVENT_ALL.
+ * @param modifiers Status bits (PS2_SHIFT, PS2_CTRL, ...) that must all be
+ *                  set in the key for the handler to be called, 0 for any.
+ *
+ * @return bool_t true if registered, false if the handler table is full.
+ */
+bool_t PS2Keyboard_Subscribe(ps2KeyHandler_t handler, uint8_t events, uint16_t modifiers);
+
+
+/**
+ * @brief Removes a handler registered with PS2Keyboard_Subscribe().
+ *
+ * @param handler Function to remove.
+ */
+void PS2Keyboard_Unsubscribe(ps2KeyHandler_t handler);
+
+
+/**
+ * @brief Copies the driver health counters.
+ *
+ * Counters accumulate from power up or the last PS2Keyboard_ResetStats()
+ * call and survive keyboard resets, so they can be used to size the
+ * _RX_BUFFER_SIZE, _TX_BUFFER_SIZE and _KEY_BUFF_SIZE queues.
+ *
+ * @param stats Where to copy the counters.
+ */
+void PS2Keyboard_GetStats(ps2Stats_t *stats);
+
+
+/**
+ * @brief Clears all driver health counters and high-water marks.
+ */
+void PS2Keyboard_ResetStats(void);
+
+
+/**
+ * @brief Prints the driver health counters on the console.
+ */
+void PS2Keyboard_PrintStats(void);
+
+
+/**
+ * @brief Queues a command for the keyboard.
+ *
+ * The descriptor is copied, so it may live on the stack. Commands are sent
+ * in order and pipelined into the transmit queue while they fit; nothing
+ * blocks. When all response bytes arrived (or the command timed out or was
+ * answered with an error after its retries) the callback is called from
+ * PS2Keyboard_Process() with the response bytes, ACKs included.
+ *
+ * Example, read the keyboard ID:
+ *   ps2Command_t cmd = { .bytes = { 0xF2 }, .len = 1, .resp_len = 2,
+ *                        .retries = 2, .callback = onId };
+ *   PS2Keyboard_SendCommand(&cmd);
+ *
+ * @param cmd Command descriptor.
+ *
+ * @return int8_t 1 if queued, -4 if the queue is full, -5 on bad parameters.
+ */
+int8_t PS2Keyboard_SendCommand(const ps2Command_t *cmd);
+
+
+/**
+ * @brief Delivers pending key events and command completions.
+ *
+ * The interrupt flags each completed scan code sequence, so key handling
+ * returns straight away when nothing arrived. Also feeds queued keyboard
+ * commands and checks their timeouts. Call it from the main loop. Without
+ * subscribed handlers keys are left for PS2Keyboard_Read(). Handlers only
+ * get key events: keyboard responses not taken by a command callback (BAT
+ * after a hot plug, RESEND, ECHO...) are dropped.
+ */
+void PS2Keyboard_Process(void);
+
+
 /**
  * @brief Retrieves the current status of the lock keys.
  * 
@@ -441,6 +579,43 @@ void PS2Keyboard_ResetKey();
 void PS2Keyboard_GetScanCodeSet(void);
 
 
+/**
+ * @brief Switches the keyboard to scan code set 3 with all keys make/break.
+ *
+ * In set 3 every key is a single byte and a break is F0 plus that byte, so
+ * there are no E0/E1 prefixes or 8 byte PAUSE sequence to follow. Keys do
+ * not auto repeat in make/break mode.
+ *
+ * Decoding switches only after the keyboard reports set 3 when read back;
+ * keyboards without set 3 support stay on set 2. The switch is repeated
+ * automatically after a keyboard reset (BAT).
+ */
+void PS2Keyboard_UseScanSet3(void);
+
+
+/**
+ * @brief Returns the scan code set currently being decoded.
+ *
+ * @return uint8_t 2 (default) or 3 once PS2Keyboard_UseScanSet3() was confirmed.
+ */
+uint8_t PS2Keyboard_ActiveScanSet(void);
+
+
+/**
+ * @brief Converts a returned key code to a character of the build layout.
+ *
+ * The layout is chosen at build time (PS2_LAYOUT_LATAM, default US) and its
+ * tables are generated by the preprocessor, see PS2KeyLayout.h. SHIFT, CAPS
+ * lock and ALT GR select the character; breaks and keys combined with CTRL,
+ * ALT or GUI return 0.
+ *
+ * @param key Key code as returned by PS2Keyboard_Read() or a handler.
+ *
+ * @return uint8_t ISO-8859-1 character, or 0 if the key has none.
+ */
+uint8_t PS2Keyboard_KeyToChar(uint16_t key);
+
+
 /**
  * @brief Requests the keyboard identification (ID).
  *
@@ -18,6 +18,38 @@
 
 #include "sapi.h"
 
+/** Clip repeat count that plays it until another drawing replaces it */
+#define ANIM_LOOP 0
+
+/** Brightness levels (MAX7219 intensity register), see Animation_SetBrightness */
+#define ANIM_BRIGHTNESS_MAX 15
+#define ANIM_BRIGHTNESS_DEFAULT 5
+
+/** Clip initializer from a frame array */
+#define ANIM_CLIP( FRAMES, REPEAT ) { (FRAMES), sizeof(FRAMES) / sizeof((FRAMES)[0]), (REPEAT) }
+
+/**
+ * @brief One animation frame.
+ */
+typedef struct {
+    uint64_t image;     /**< Panel 0 image, led-matrix-editor format */
+    uint16_t ms;        /**< Time the frame stays on, greater than 0 */
+} animFrame_t;
+
+/**
+ * @brief Animation played by Animation_Play(). Keep it const (flash).
+ */
+typedef struct {
+    const animFrame_t *frames;
+    uint8_t count;      /**< Number of frames */
+    uint8_t repeat;     /**< Passes before stopping on the last frame, or ANIM_LOOP */
+} animClip_t;
+
+/**
+ * @brief Called at the end of every pass of a clip.
+ */
+typedef void (*animDone_t)(const animClip_t *clip);
+
 /**
  * @brief Initializes the animation system.
  *
@@ -25,6 +57,79 @@
  */
 void Animation_Init(void);
 
+/**
+ * @brief Advances the playing clip and sends the last drawn frame if the
+ * frame rate limit deferred it.
+ *
+ * Call it on every main loop iteration.
+ */
+void Animation_Update(void);
+
+/**
+ * @brief Prints the display pipeline counters since the last reset:
+ * frames committed and sent, rows and bytes sent, SPI reconfigurations
+ * and CPU time blocked on the bus.
+ */
+void Animation_PrintStats(void);
+
+/**
+ * @brief Clears the display pipeline counters.
+ */
+void Animation_ResetStats(void);
+
+/**
+ * @brief Starts a clip from its first frame, replacing the one playing.
+ *
+ * Frames advance on Animation_Update(). Any other drawing function stops
+ * the clip.
+ *
+ * @param clip The clip to play.
+ * @param on_done Called at the end of every pass. May be NULL.
+ */
+void Animation_Play(const animClip_t *clip, animDone_t on_done);
+
+/**
+ * @brief Checks if a clip is playing.
+ *
+ * @return true until the clip stops or is stopped.
+ */
+bool_t Animation_IsPlaying(void);
+
+/**
+ * @brief Sets the display brightness, stopping any fade or pulse.
+ *
+ * Brightness effects only write the intensity register, they run on
+ * Animation_Update() independently of the drawn frames and clips.
+ *
+ * @param level 0 to ANIM_BRIGHTNESS_MAX.
+ */
+void Animation_SetBrightness(uint8_t level);
+
+/**
+ * @brief Ramps the brightness from the current level to another one.
+ *
+ * @param level Final level, kept once reached.
+ * @param ms Duration of the ramp.
+ */
+void Animation_Fade(uint8_t level, uint16_t ms);
+
+/**
+ * @brief Pulses the brightness between two levels until another
+ * brightness function is called.
+ *
+ * @param low Dimmest level, where each period starts.
+ * @param high Brightest level, reached at half period.
+ * @param period_ms Duration of a dim-bright-dim cycle.
+ */
+void Animation_Pulse(uint8_t low, uint8_t high, uint16_t period_ms);
+
+/**
+ * @brief Checks if a fade or pulse is running.
+ *
+ * @return true until a fade reaches its level, always for a pulse.
+ */
+bool_t Animation_IsFading(void);
+
 /**
  * @brief Displays a single character on the LED matrix.
  *
@@ -32,6 +137,13 @@ void Animation_Init(void);
  */
 void Animation_DrawCharacter(char c);
 
+/**
+ * @brief Displays a word, one character per panel.
+ *
+ * @param text The text to display, extra characters are not shown.
+ */
+void Animation_DrawText(const char *text);
+
 /**
  * @brief Displays a two-digit number on the LED matrix.
  *
@@ -46,6 +158,16 @@ void Animation_DrawNumber(uint8_t number);
  */
 void Animation_DrawRomanNumber(uint8_t number);
 
+/**
+ * @brief Marks the rotor being configured, drawn over the numbers.
+ *
+ * The mark appears with the next Animation_DrawNumber() or
+ * Animation_DrawRomanNumber() and stays until removed.
+ *
+ * @param rotor Rotor number (1-3), 0 removes the mark.
+ */
+void Animation_SetRotorIndicator(uint8_t rotor);
+
 /**
  * @brief Scrolls a text message across the LED matrix.
  *
@@ -66,6 +188,9 @@ bool_t Animation_WaitInput(bool_t reset);
 /**
  * @brief Displays a loading animation.
  *
+ * Built with MATRIX_GRAY_PLANES the spinner leaves a fading trail, drawn
+ * with the gray planes until another drawing takes the display.
+ *
  * @param reset If true, resets the animation.
  * @return true when the animation cycle completes, false otherwise.
  */
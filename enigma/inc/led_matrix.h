@@ -45,6 +45,70 @@
 /*==================[macros and definitions]=================================*/
 
 #define MATRIX_SIZE MAX7219_SIZE
+#define MATRIX_PANELS MAX7219_PANELS	/**< 8x8 panels side by side, panel 0 holds x = 1 to 8 */
+#define MATRIX_WIDTH MAX7219_WIDTH
+
+/**
+ * @brief Default maximum frames sent per second, see MatrixSetFrameRate
+ */
+#ifndef MATRIX_FPS
+#define MATRIX_FPS 50
+#endif
+
+/*
+ * Build with MATRIX_GRAY_PLANES=2 or 3 for grayscale: each pixel has a
+ * level of that many bits, shown by binary coded modulation. Bit plane k
+ * stays on the chips for 2^k time units, switched by TIMER1 with dirty row
+ * updates. Requires MAX7219_USE_DMA, the timer ISR only queues transfers.
+ */
+#if defined(MATRIX_GRAY_PLANES)
+#if !defined(MAX7219_USE_DMA)
+#error "MATRIX_GRAY_PLANES requires MAX7219_USE_DMA"
+#endif
+#define MATRIX_GRAY_LEVELS (1 << MATRIX_GRAY_PLANES)
+
+/**
+ * @brief Bit plane cycles per second. A plane must be sent within one time
+ * unit, 1 / (MATRIX_GRAY_HZ * (MATRIX_GRAY_LEVELS - 1)), or it is shown late
+ */
+#ifndef MATRIX_GRAY_HZ
+#define MATRIX_GRAY_HZ 100
+#endif
+#endif
+
+/**
+ * @brief Orientation tag from degrees (0, 90, 180 or 270), usable in macros
+ */
+#define MATRIX_ORIENTATION(deg)		MATRIX_ORIENTATION_(deg)
+#define MATRIX_ORIENTATION_(deg)	ROT_##deg##_CW
+
+/**
+ * @brief Compile-time version of the orientation applied by MatrixSetImage
+ *
+ * Converts a constant uint64_t image to the MAX7219 data buffer layout for
+ * the orientation given in degrees (0, 90, 180 or 270), so image tables can
+ * be built pre-rotated and sent with MatrixSetRawImage. Images in that
+ * layout can be OR'ed together.
+ */
+#define MATRIX_RAW_IMAGE(img, deg) 	MATRIX_RAW_IMAGE_(img, deg)
+#define MATRIX_RAW_IMAGE_(img, deg) ( \
+		MATRIX_RAW_ROW_(img, 0, deg) | MATRIX_RAW_ROW_(img, 1, deg) | \
+		MATRIX_RAW_ROW_(img, 2, deg) | MATRIX_RAW_ROW_(img, 3, deg) | \
+		MATRIX_RAW_ROW_(img, 4, deg) | MATRIX_RAW_ROW_(img, 5, deg) | \
+		MATRIX_RAW_ROW_(img, 6, deg) | MATRIX_RAW_ROW_(img, 7, deg) )
+#define MATRIX_RAW_ROW_(img, r, deg) ( \
+		MATRIX_RAW_PIX_(img, r, 0, deg) | MATRIX_RAW_PIX_(img, r, 1, deg) | \
+		MATRIX_RAW_PIX_(img, r, 2, deg) | MATRIX_RAW_PIX_(img, r, 3, deg) | \
+		MATRIX_RAW_PIX_(img, r, 4, deg) | MATRIX_RAW_PIX_(img, r, 5, deg) | \
+		MATRIX_RAW_PIX_(img, r, 6, deg) | MATRIX_RAW_PIX_(img, r, 7, deg) )
+#define MATRIX_RAW_PIX_(img, r, c, deg) \
+		((((uint64_t) (img) >> ((r) * 8 + (c))) & 1) << MATRIX_RAW_BIT_##deg(r, c))
+
+/* Buffer bit (row * 8 + bit) of image row r, column c, same as TransformPoint */
+#define MATRIX_RAW_BIT_0(r, c)		((r) * 8 + 7 - (c))
+#define MATRIX_RAW_BIT_90(r, c)		((c) * 8 + (r))
+#define MATRIX_RAW_BIT_180(r, c)	((7 - (r)) * 8 + (c))
+#define MATRIX_RAW_BIT_270(r, c)	((7 - (c)) * 8 + 7 - (r))
 
 /*==================[typedef]================================================*/
 
@@ -73,13 +137,60 @@ typedef enum {
 	X_PLUS_1, X_MINUS_1, Y_PLUS_1, Y_MINUS_1
 } moveDir_t;
 
+/**
+ * @brief Compositor layers, bottom to top
+ */
+typedef enum {
+	LAYER_BACKGROUND, LAYER_TEXT, LAYER_OVERLAY,
+	MATRIX_LAYERS
+} matrixLayer_t;
+
+/**
+ * @brief Layer images in uint64_t format, one per panel
+ */
+typedef struct {
+	uint64_t img[MATRIX_PANELS];
+	uint64_t mask[MATRIX_PANELS];	/**< Pixels the layer covers, lit or not */
+} matrixLayerData_t;
+
+/**
+ * @brief Frame counters, see MatrixGetStats
+ */
+typedef struct {
+	uint32_t commits;	/**< MatrixUpdate calls */
+	uint32_t unchanged;	/**< Commits equal to the previous frame */
+	uint32_t replaced;	/**< Deferred frames replaced by a newer commit */
+	uint32_t sent;		/**< Frames sent to the MAX7219 */
+#if defined(MATRIX_GRAY_PLANES)
+	uint32_t gray_cycles;	/**< Bit plane cycles shown */
+	uint32_t gray_late;		/**< Plane switches delayed a time unit, SPI bus busy */
+#endif
+} matrixStats_t;
+
 /**
  * @brief Led Matrix configuration structure
+ *
+ * Drawing functions write the back buffer. MatrixUpdate commits it to the
+ * MAX7219 data buffer (front), so the matrix never shows a half drawn frame.
  */
 typedef struct {
 	max7219_t dev;
 	matrixOrientation_t ori;
 	stagedPoint_t st_pt;
+	max7219Data_t back[MATRIX_PANELS];	/**< Drawing buffer */
+	tick_t frame_ms;		/**< Minimum time between transfers. 0: no limit */
+	tick_t last_sent;		/**< Time of the last transfer */
+	bool pending;			/**< Committed frame not sent yet */
+	matrixStats_t stats;
+	matrixLayerData_t layers[MATRIX_LAYERS];
+#if defined(MATRIX_GRAY_PLANES)
+	uint64_t gray[MATRIX_GRAY_PLANES][MATRIX_PANELS];		/**< Gray drawing planes, buffer layout */
+	uint64_t gray_front[MATRIX_GRAY_PLANES][MATRIX_PANELS];	/**< Planes on display */
+	volatile bool gray_on;
+	volatile bool gray_commit;	/**< Drawing planes ready, taken at the next cycle */
+	uint8_t gray_slot;			/**< Time unit of the cycle */
+	uint8_t gray_shown;			/**< Plane on the chips */
+#endif
 } ledMatrix_t;
 
 /*==================[external functions declaration]=========================*/
@@ -98,7 +209,12 @@ typedef struct {
 void MatrixInit(ledMatrix_t *mat, max7219_t dev, matrixOrientation_t ori);
 
 /**
- * @brief Updates the led matrix. Call it to reflect changes on MAX7219 matrix
+ * @brief Commits the drawn frame. Call it to reflect changes on MAX7219 matrix
+ *
+ * The back buffer is copied to the MAX7219 data buffer and sent at once
+ * unless the frame rate limit defers it. A deferred frame is replaced by a
+ * newer commit, only the last one is sent (see MatrixFlush). In gray mode
+ * the gray planes are committed instead.
  *
  * @param[in] mat 	Pointer to led matrix configuration structure
  *
@@ -106,7 +222,85 @@ void MatrixInit(ledMatrix_t *mat, max7219_t dev, matrixOrientation_t ori);
 void MatrixUpdate(ledMatrix_t *mat);
 
 /**
- * @brief Clears the matrix data buffer.
+ * @brief Sends the committed frame if it was deferred and the frame rate
+ * allows it now. Call it on main program loop
+ *
+ * @param[in] mat 	Pointer to led matrix configuration structure
+ *
+ */
+void MatrixFlush(ledMatrix_t *mat);
+
+/**
+ * @brief Sets the maximum frames sent per second
+ *
+ * @param[in] mat 	Pointer to led matrix configuration structure
+ * @param[in] fps	Frames per second. 0: every commit is sent
+ *
+ */
+void MatrixSetFrameRate(ledMatrix_t *mat, uint16_t fps);
+
+#if defined(MATRIX_GRAY_PLANES)
+/**
+ * @brief Starts showing the gray planes instead of the drawing buffer
+ *
+ * Only one matrix can be in gray mode. MatrixUpdate commits the gray planes
+ * for the next bit plane cycle, MatrixFlush does nothing.
+ *
+ * @param[in] mat 	Pointer to led matrix configuration structure
+ *
+ */
+void MatrixGrayStart(ledMatrix_t *mat);
+
+/**
+ * @brief Stops gray mode and sends the drawing buffer again
+ *
+ * @param[in] mat 	Pointer to led matrix configuration structure
+ *
+ */
+void MatrixGrayStop(ledMatrix_t *mat);
+
+/**
+ * @brief Clears the gray drawing planes
+ *
+ * @param[in] mat 	Pointer to led matrix configuration structure
+ *
+ */
+void MatrixGrayBlank(ledMatrix_t *mat);
+
+/**
+ * @brief Sets a gray image on a panel with the current orientation
+ *
+ * @param[in] mat 	Pointer to led matrix configuration structure
+ * @param[in] panel	Panel index (0 to MATRIX_PANELS - 1)
+ * @param[in] planes	Images of uint64_t format, planes[k] holds bit k of
+ * 					every pixel level
+ *
+ */
+void MatrixSetGrayImage(ledMatrix_t *mat, uint8_t panel,
+		const uint64_t planes[MATRIX_GRAY_PLANES]);
+#endif
+
+/**
+ * @brief Gets the frame counters
+ *
+ * Counters accumulate from initialization or the last MatrixClearStats()
+ *
+ * @param[in] mat 	Pointer to led matrix configuration structure
+ * @param[out] stats	Counters
+ *
+ */
+void MatrixGetStats(ledMatrix_t *mat, matrixStats_t *stats);
+
+/**
+ * @brief Clears the frame counters
+ *
+ * @param[in] mat 	Pointer to led matrix configuration structure
+ *
+ */
+void MatrixClearStats(ledMatrix_t *mat);
+
+/**
+ * @brief Clears the drawing buffer.
  *
  * @param[in] mat 	Pointer to led matrix configuration structure
  *
@@ -116,6 +310,8 @@ void MatrixBlank(ledMatrix_t *mat);
 /**
  * @brief Rotates the matrix data buffer as indicates second parameter
  *
+ * Each panel of a chain is rotated in place.
+ *
  * @param[in] mat 	Pointer to led matrix configuration structure
  * @param[in] ori 	Orientation. See 'MATRIX ORIENTATION TAGS'
  *
@@ -163,7 +359,7 @@ ledStatus_t MatrixTogPoint(ledMatrix_t *mat, uint8_t x, uint8_t y);
 ledStatus_t MatrixGetPoint(ledMatrix_t *mat, uint8_t x, uint8_t y);
 
 /**
- * @brief Sets an image in the data buffer with the current orientation
+ * @brief Sets an image in the data buffer of panel 0 with the current orientation
  *
  * @param[in] mat 	Pointer to led matrix configuration structure
  * @param[in] img	Image of uint64_t format
@@ -175,7 +371,50 @@ ledStatus_t MatrixGetPoint(ledMatrix_t *mat, uint8_t x, uint8_t y);
 void MatrixSetImage(ledMatrix_t *mat, uint64_t img);
 
 /**
- * @brief Gets the image in the data buffer with the current orientation. TODO: Implementation
+ * @brief Sets an image already in the data buffer layout (no orientation) on panel 0
+ *
+ * @param[in] mat 	Pointer to led matrix configuration structure
+ * @param[in] raw	Image built with MATRIX_RAW_IMAGE for the matrix orientation.
+ * 					Byte n is MAX7219 digit n
+ *
+ */
+void MatrixSetRawImage(ledMatrix_t *mat, uint64_t raw);
+
+/**
+ * @brief Sets an image in the data buffer of a panel with the current orientation
+ *
+ * @param[in] mat 	Pointer to led matrix configuration structure
+ * @param[in] panel	Panel index (0 to MATRIX_PANELS - 1)
+ * @param[in] img	Image of uint64_t format
+ *
+ */
+void MatrixSetPanelImage(ledMatrix_t *mat, uint8_t panel, uint64_t img);
+
+/**
+ * @brief Sets an image already in the data buffer layout on a panel
+ *
+ * @param[in] mat 	Pointer to led matrix configuration structure
+ * @param[in] panel	Panel index (0 to MATRIX_PANELS - 1)
+ * @param[in] raw	Image built with MATRIX_RAW_IMAGE for the matrix orientation
+ *
+ */
+void MatrixSetPanelRawImage(ledMatrix_t *mat, uint8_t panel, uint64_t raw);
+
+/**
+ * @brief Scrolls the drawing buffer one column, with the current orientation
+ *
+ * Every panel moves one column towards the last panel of the chain and
+ * takes the column leaving the previous panel, the column of the last
+ * panel is lost. The new column enters panel 0.
+ *
+ * @param[in] mat 	Pointer to led matrix configuration structure
+ * @param[in] column	Image of uint64_t format, only column 0 (bit 0 of every row) is used
+ *
+ */
+void MatrixScroll(ledMatrix_t *mat, uint64_t column);
+
+/**
+ * @brief Gets the image of panel 0 in the drawing buffer with the current orientation
  *
  * @param[in] mat 	Pointer to led matrix configuration structure
  * @param[out] img	Pointer to uint64_t to save the image
@@ -183,6 +422,61 @@ void MatrixSetImage(ledMatrix_t *mat, uint64_t img);
  */
 void MatrixGetImage(ledMatrix_t *mat, uint64_t *img);
 
+/**
+ * @brief Gets the image of a panel in the drawing buffer with the current orientation
+ *
+ * @param[in] mat 	Pointer to led matrix configuration structure
+ * @param[in] panel	Panel index (0 to MATRIX_PANELS - 1)
+ * @param[out] img	Pointer to uint64_t to save the image, 0 for an invalid panel
+ *
+ */
+void MatrixGetPanelImage(ledMatrix_t *mat, uint8_t panel, uint64_t *img);
+
+/*
+ * Compositor. Layers hold uint64_t format images spanning the chain left to
+ * right the way MatrixScroll moves them: the last panel on the left, panel 0
+ * on the right. x = 0 is the left column of the last panel, y = 0 the top row.
+ * MatrixCompose stacks them into the drawing buffer, a masked pixel of an
+ * upper layer hides the layers below, lit or not.
+ */
+
+/**
+ * @brief Clears a layer, it no longer covers any pixel
+ *
+ * @param[in] mat 	Pointer to led matrix configuration structure
+ * @param[in] layer	Layer
+ *
+ */
+void MatrixClearLayer(ledMatrix_t *mat, matrixLayer_t layer);
+
+/**
+ * @brief Draws an 8x8 sprite on a layer
+ *
+ * Parts out of the chain are clipped.
+ *
+ * @param[in] mat 	Pointer to led matrix configuration structure
+ * @param[in] layer	Layer
+ * @param[in] sprite	Image of uint64_t format
+ * @param[in] mask	Sprite pixels drawn. Pass the sprite for a transparent
+ * 					background, all ones for an opaque 8x8 box
+ * @param[in] x		Column of the sprite left edge, may be negative
+ * @param[in] y		Row of the sprite top edge (-7 to 7)
+ *
+ */
+void MatrixBlit(ledMatrix_t *mat, matrixLayer_t layer, uint64_t sprite,
+		uint64_t mask, int16_t x, int8_t y);
+
+/**
+ * @brief Replaces the drawing buffer with the layers stacked bottom to top
+ *
+ * Call MatrixUpdate to commit it. Points and images can still be drawn
+ * over the result before the commit.
+ *
+ * @param[in] mat 	Pointer to led matrix configuration structure
+ *
+ */
+void MatrixCompose(ledMatrix_t *mat);
+
 /* -----  STAGED POINT FUNCTIONS ----- */
 
 /**
@@ -71,6 +71,7 @@
 /* Intensity register format */
 #define	MIN_INTENSITY		1
 #define MAX_INTENSITY 		15
+#define DEFAULT_INTENSITY	5	/**< Set by Max7219Init */
 #define SET_INTENSITY(x) 	(x & 0x0F)
 
 /* Scan limit register format */
@@ -83,6 +84,24 @@
 /* Side size (number of leds) of a led matrix */
 #define MAX7219_SIZE 8
 
+/* Number of MAX7219 daisy-chained on one chip select (DOUT to DIN) */
+#ifndef MAX7219_PANELS
+#define MAX7219_PANELS 1
+#endif
+
+/* Width (number of leds) of the whole chain */
+#define MAX7219_WIDTH (MAX7219_SIZE * MAX7219_PANELS)
+
+/* Build with MAX7219_USE_DMA to send updates with SpiDevWriteAsync() */
+
+/*
+ * Build with MAX7219_TRACE to decode every packet sent into a copy of the
+ * chips digit registers, with update timing and traffic statistics
+ * (see Max7219TraceReport). Works on target and on the host: `make trace`
+ * in enigma/test runs led_matrix and animation unchanged over a stubbed
+ * SPI HAL and sAPI (enigma/test/host) and writes a PPM image per frame.
+ */
+
 /*==================[typedef]================================================*/
 
 /**
@@ -99,13 +118,34 @@ typedef enum {
  */
 typedef uint8_t max7219Data_t[MAX7219_SIZE];
 
+/**
+ * @brief Update counters, see Max7219GetStats
+ */
+typedef struct {
+	uint32_t updates;	/**< Max7219Update calls */
+	uint32_t idle;		/**< Updates with no row changed, nothing sent */
+	uint32_t frames;	/**< Row frames sent (one packet per panel) */
+	uint32_t rows;		/**< Panel rows rewritten */
+} max7219Stats_t;
+
 /**
  * @brief MAX7219 configuration structure
+ *
+ * Panel 0 is the chip wired to the microcontroller, x = 1 to 8 are its
+ * columns, x = 9 to 16 the next chip's and so on.
  */
 typedef struct {
 	spiDevice_t spi;	/**< SPI: Device */
 	gpioMap_t cs;		/**< GPIO: Chip Select */
-	max7219Data_t data; /**< Matrix data buffer. Reflects state of the led matrix */
+	max7219Data_t data[MAX7219_PANELS]; /**< Matrix data buffer per panel. Reflects state of the led matrix */
+	max7219Data_t sent[MAX7219_PANELS]; /**< Rows last transmitted. Only changed rows are sent */
+	bool synced;		/**< 'sent' matches the MAX7219 digit registers */
+	uint8_t intensity;	/**< Intensity register of every chip */
+	uint16_t frames[MAX7219_SIZE][MAX7219_PANELS]; /**< Row frames of the last update, kept until sent */
+	max7219Stats_t stats;
+#if defined(MAX7219_USE_DMA)
+	spiTransfer_t xfer[MAX7219_SIZE];	/**< One chip select frame per row */
+#endif
 } max7219_t;
 
 /*==================[external data declaration]==============================*/
@@ -117,6 +157,8 @@ extern spiConfig_t max7219_spi_default_cfg; /**< Used on initialization function
 /**
  * @brief Initialize MAX7219 module attached with a led matrix
  *
+ * Configures every chip of the chain (MAX7219_PANELS).
+ *
  * @param[in] max7219 	Pointer to MAX7219 configuration structure
  * @param[in] cs_pin 	GPIO pin
  * @param[in] cfg	 	SPI configuration
@@ -127,11 +169,52 @@ void Max7219Init(max7219_t *max7219, gpioMap_t cs_pin, spiConfig_t cfg);
 /**
  * @brief Transfer the data buffer to led matrix. Updates matrix
  *
+ * Only the rows that changed since the last update are sent, nothing is
+ * sent if no row changed. A changed row goes to all the panels in one
+ * chip select frame, panels whose row did not change get a no-op.
+ * The frames are queued and sent in one batch (see SpiDevQueueWrite).
+ *
+ * With MAX7219_USE_DMA the frames are queued and the function returns
+ * before they are sent, chip select is driven from the DMA interrupt.
+ * The next update waits for them first.
+ *
  * @param[in] max7219 	Pointer to MAX7219 configuration struct
  *
  */
 void Max7219Update(max7219_t *max7219);
 
+/**
+ * @brief Forces the next update to send every row
+ *
+ * Use it if the MAX7219 could have lost its registers (e.g. power glitch)
+ *
+ * @param[in] max7219 	Pointer to MAX7219 configuration struct
+ *
+ */
+void Max7219Invalidate(max7219_t *max7219);
+
+/**
+ * @brief Sets the brightness of the whole chain
+ *
+ * Only the INTENSITY register is written (one packet per panel), the
+ * data buffer and digit registers are untouched. Nothing is sent if the
+ * level does not change, so it can be called on every animation step.
+ *
+ * @param[in] max7219 	Pointer to MAX7219 configuration structure
+ * @param[in] level		0 to MAX_INTENSITY, higher levels are clamped
+ *
+ */
+void Max7219SetIntensity(max7219_t *max7219, uint8_t level);
+
+/**
+ * @brief Gets the brightness last set
+ *
+ * @param[in] max7219 	Pointer to MAX7219 configuration structure
+ *
+ * @return Intensity level
+ */
+uint8_t Max7219GetIntensity(max7219_t *max7219);
+
 /**
  * @brief Set data buffer to zero
  *
@@ -144,7 +227,7 @@ void Max7219Blank(max7219_t *max7219);
  * @brief Sets a specific matrix point
  *
  * @param[in] max7219 	Pointer to MAX7219 configuration struct
- * @param[in] x			x position of led
+ * @param[in] x			x position of led (1 to MAX7219_WIDTH)
  * @param[in] y			y position of led
  *
  * @return Point status. See 'Status point codes'
@@ -156,7 +239,7 @@ ledStatus_t Max7219SetPoint(max7219_t *max7219, uint8_t x, uint8_t y);
  * @brief Resets a specific matrix point
  *
  * @param[in] max7219 	Pointer to MAX7219 configuration struct
- * @param[in] x			x position of led
+ * @param[in] x			x position of led (1 to MAX7219_WIDTH)
  * @param[in] y			y position of led
  *
  * @return Point status. See 'Status point codes'
@@ -168,7 +251,7 @@ ledStatus_t Max7219ResetPoint(max7219_t *max7219, uint8_t x, uint8_t y);
  * @brief Toggles a specific matrix point
  *
  * @param[in] max7219 	Pointer to MAX7219 configuration struct
- * @param[in] x			x position of led
+ * @param[in] x			x position of led (1 to MAX7219_WIDTH)
  * @param[in] y			y position of led
  *
  * @return Point status. See 'Status point codes'
@@ -180,7 +263,7 @@ ledStatus_t Max7219TogglePoint(max7219_t *max7219, uint8_t x, uint8_t y);
  * @brief Gets a specific matrix point status
  *
  * @param[in] max7219 	Pointer to MAX7219 configuration struct
- * @param[in] x			x position of led
+ * @param[in] x			x position of led (1 to MAX7219_WIDTH)
  * @param[in] y			y position of led
  *
  * @return Point status. See 'Status point codes'
@@ -189,23 +272,70 @@ ledStatus_t Max7219TogglePoint(max7219_t *max7219, uint8_t x, uint8_t y);
 ledStatus_t Max7219GetPoint(max7219_t *max7219, uint8_t x, uint8_t y);
 
 /**
- * @brief Sets the matrix data buffer
+ * @brief Sets the data buffer of a panel
  *
  * @param[in] max7219 	Pointer to MAX7219 configuration struct
+ * @param[in] panel		Panel index (0 to MAX7219_PANELS - 1)
  * @param[in] src_img	Source data buffer of type max7219Data_t
  *
  */
-void Max7219SetImage(max7219_t *max7219, max7219Data_t src_img);
+void Max7219SetImage(max7219_t *max7219, uint8_t panel, max7219Data_t src_img);
 
 /**
- * @brief Gets a copy of matrix data buffer
+ * @brief Gets a copy of the data buffer of a panel
  *
  * @param[in] max7219 	Pointer to MAX7219 configuration struct
+ * @param[in] panel		Panel index (0 to MAX7219_PANELS - 1)
  * @param[out] tar_img	Target data buffer of type max7219Data_t
  *
  */
-void Max7219GetImage(max7219_t *max7219, max7219Data_t tar_img);
+void Max7219GetImage(max7219_t *max7219, uint8_t panel, max7219Data_t tar_img);
+
+/**
+ * @brief Gets the update counters
+ *
+ * Counters accumulate from initialization or the last Max7219ClearStats()
+ *
+ * @param[in] max7219 	Pointer to MAX7219 configuration struct
+ * @param[out] stats	Counters
+ *
+ */
+void Max7219GetStats(max7219_t *max7219, max7219Stats_t *stats);
+
+/**
+ * @brief Clears the update counters
+ *
+ * @param[in] max7219 	Pointer to MAX7219 configuration struct
+ *
+ */
+void Max7219ClearStats(max7219_t *max7219);
+
+#if defined(MAX7219_TRACE)
+/**
+ * @brief Clears the trace statistics. The decoded registers are kept
+ */
+void Max7219TraceReset(void);
+
+/**
+ * @brief Prints updates per second, digit frame bytes per update, the share
+ * of no-op packets padding those frames and the bytes of control frames
+ * (init, intensity). Unchanged rows are never sent, redundant frames show
+ * in the led_matrix statistics (unchanged and replaced commits)
+ */
+void Max7219TraceReport(void);
 
+/**
+ * @brief Prints the led state decoded from the packets, '#' is on.
+ * Same x, y as the point functions
+ */
+void Max7219TraceRender(void);
+
+/**
+ * @brief Prints the led state decoded from the packets as a PPM image
+ * (plain P3 format), one pixel per led
+ */
+void Max7219TracePpm(void);
+#endif
 
 #endif /* PROJECTS_SPI_TEST_INC_MATRIX_LED_H_ */
 /** @} doxygen end group definition */
@@ -0,0 +1,168 @@
+/**
+ * @file ring_buffer.h
+ * @brief Lock-free single-producer/single-consumer ring buffer for driver queues.
+ *
+ * One side (typically an ISR) only pushes and the other side (typically the
+ * main loop) only pops or peeks. No interrupt masking is needed as long
+ * as that split is respected: each index is written by exactly one side and
+ * memory barriers order the element accesses against the index updates.
+ *
+ * A side shared by two contexts must serialize them itself. The PS/2 TX
+ * buffer is popped both by the clock ISR and by the main loop, which masks
+ * the clock interrupt around its pops.
+ *
+ * Indexes are free running 8-bit counters masked on access, so the size must
+ * be a power of two (2 to 128) and the whole size is usable.
+ *
+ * @author
+ *   - Juan Bautista Iacobucci <link00222@gmail.com>
+ *   - Fernando Ramirez Tolentino <fernandoramireztolentino@hotmail.com>
+ *   - Lisandro Martinez <lisandromartz@gmail.com>
+ * @date 2025/03/10
+ *
+ * @copyright
+ * Released under the MIT License.
+ */
+
+/*=====[Avoid multiple inclusion - begin]====================================*/
+
+#ifndef __RING_BUFFER_H__
+#define __RING_BUFFER_H__
+
+/*=====[Inclusions of public function dependencies]==========================*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*=====[C++ - begin]=========================================================*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*=====[Public function-like macros]=========================================*/
+
+/**
+ * @brief Static initializer for a ring buffer over a power-of-two sized array.
+ *
+ * Example: `static uint16_t data[8]; ringBuffer_t rb = RING_BUFFER_INIT(data);`
+ */
+#define RING_BUFFER_INIT(storage) \
+    { (storage), (uint8_t)(RING_BUFFER_LENGTH(storage) - 1), 0, 0, 0, 0 }
+
+/**
+ * @brief Element count of a storage array. Fails to compile unless it is a
+ * power of two from 2 to 128 (negative array size).
+ */
+#define RING_BUFFER_LENGTH(storage) \
+    (sizeof(storage) / sizeof((storage)[0]) \
+     + 0 * sizeof(char[RING_BUFFER_SIZE_OK(sizeof(storage) / sizeof((storage)[0])) ? 1 : -1]))
+
+/**
+ * @brief Non-zero if n is a valid ring buffer size.
+ */
+#define RING_BUFFER_SIZE_OK(n) ((n) >= 2 && (n) <= 128 && ((n) & ((n) - 1)) == 0)
+
+/*=====[Definitions of public data types]====================================*/
+
+/**
+ * @brief Ring buffer control structure.
+ */
+typedef struct {
+    uint16_t *data;          /**< Element storage, power-of-two sized */
+    uint8_t mask;            /**< Size - 1, used to wrap the indexes */
+    volatile uint8_t head;   /**< Free running write index (producer only) */
+    volatile uint8_t tail;   /**< Free running read index (consumer only) */
+    volatile uint16_t overflows; /**< Pushes rejected because the buffer was full */
+    volatile uint8_t high_water; /**< Highest element count reached */
+} ringBuffer_t;
+
+/*=====[Prototypes (declarations) of public functions]=======================*/
+
+/**
+ * @brief Initializes a ring buffer over the given storage.
+ *
+ * @param rb      Ring buffer to initialize.
+ * @param storage Element storage.
+ * @param size    Number of elements in storage. Must be a power of two (2 to 128).
+ */
+void RingBuffer_Init(ringBuffer_t *rb, uint16_t *storage, uint8_t size);
+
+/**
+ * @brief Empties the buffer. The overflow and high-water statistics are kept.
+ *
+ * Only safe while neither side is accessing the buffer.
+ *
+ * @param rb Ring buffer.
+ */
+void RingBuffer_Reset(ringBuffer_t *rb);
+
+/**
+ * @brief Clears the overflow counter and the high-water mark.
+ *
+ * @param rb Ring buffer.
+ */
+void RingBuffer_ClearStats(ringBuffer_t *rb);
+
+/**
+ * @brief Appends an element (producer side).
+ *
+ * Also raises the high-water mark when the new count exceeds it.
+ *
+ * @param rb    Ring buffer.
+ * @param value Element to store.
+ * @return true if stored, false if the buffer was full (overflow counted).
+ */
+bool RingBuffer_Push(ringBuffer_t *rb, uint16_t value);
+
+/**
+ * @brief Removes the oldest element (consumer side).
+ *
+ * @param rb    Ring buffer.
+ * @param value Where to store the element. May be NULL to just drop it.
+ * @return true if an element was removed, false if the buffer was empty.
+ */
+bool RingBuffer_Pop(ringBuffer_t *rb, uint16_t *value);
+
+/**
+ * @brief Reads an element without removing it (consumer side).
+ *
+ * @param rb     Ring buffer.
+ * @param offset Position from the oldest element (0 = next to pop).
+ * @param value  Where to store the element.
+ * @return true if the element exists, false otherwise.
+ */
+bool RingBuffer_Peek(ringBuffer_t *rb, uint8_t offset, uint16_t *value);
+
+/**
+ * @brief Returns the number of stored elements.
+ *
+ * @param rb Ring buffer.
+ * @return Element count (0 to size).
+ */
+uint8_t RingBuffer_Count(ringBuffer_t *rb);
+
+/**
+ * @brief Returns true if no element can be pushed.
+ *
+ * @param rb Ring buffer.
+ */
+bool RingBuffer_IsFull(ringBuffer_t *rb);
+
+/**
+ * @brief Returns true if no element can be popped.
+ *
+ * @param rb Ring buffer.
+ */
+bool RingBuffer_IsEmpty(ringBuffer_t *rb);
+
+/*=====[C++ - end]===========================================================*/
+
+#ifdef __cplusplus
+}
+#endif
+
+/*=====[Avoid multiple inclusion - end]======================================*/
+
+#endif /* __RING_BUFFER_H__ */
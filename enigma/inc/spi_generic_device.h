@@ -32,6 +32,13 @@
 
 /** @addtogroup spi_generic_device SPI generic device
  *  @brief Manager for shared SPI. Supports different SPI device configuration
+ *
+ *  Each SSP bus is leased to one execution context (thread or ISR) at a
+ *  time, no interrupt is masked. Blocking calls take the lease. An ISR that
+ *  needs the bus uses SpiDevTryLock() and, when the bus is taken, skips
+ *  or retries its work later (e.g. on its next tick) instead of calling
+ *  the blocking functions. A blocking call from an ISR that preempted the
+ *  lease owner would wait forever, it fails an assertion instead.
  *  @{
  */
 #ifndef MODULES_LPC4337_M4_DRIVERS_BM_GPIO_HAL_H_
@@ -41,6 +48,15 @@
 
 #include "spi_master_hal.h"
 
+/*==================[macros and definitions]=================================*/
+
+/**
+ * @brief Writes queued per SSP module before they are flushed
+ */
+#ifndef SPI_BATCH_SIZE
+#define SPI_BATCH_SIZE 8
+#endif
+
 /*==================[typedef]================================================*/
 /**
  * @brief SPI generic device configuration structure: ID + SPI configuration
@@ -50,6 +66,24 @@ typedef struct {
 	spiConfig_t cfg;  	/**< SPI configuration associated with the device*/
 } spiDevice_t;
 
+/**
+ * @brief SPI bus statistics, see SpiDevGetStats
+ */
+typedef struct {
+	uint32_t transfers;		/**< Chip select frames or merged writes sent, DMA ones included */
+	uint32_t bytes;			/**< Bytes on the bus */
+	uint32_t reconfigs;		/**< SSP reconfigurations for a different device */
+	uint32_t blocked_us;	/**< CPU time waiting in blocking transfers and for pending DMA */
+	uint32_t hold_us_max;	/**< Longest lease. Worst wait of an ISR retrying SpiDevTryLock */
+	uint32_t busy;			/**< SpiDevTryLock calls that found the bus taken */
+} spiBusStats_t;
+
+/**
+ * @brief Called before (active) and after a queued write, e.g. to drive
+ * the chip select
+ */
+typedef void (*spiSelect_t)(void *ctx, bool active);
+
 /*==================[external functions declaration]=========================*/
 
 /**
@@ -96,20 +130,86 @@ void SpiDevReadBlocking(spiDevice_t *dev,uint8_t *buffer,uint32_t bytes_to_r);
 void SpiDevRWBlocking(spiDevice_t *dev, void *buffer_tx,uint8_t *buffer_rx, uint32_t bytes_to_rw );
 
 /**
- * @brief Sets pin interrupts (ISR that use SPI) that must be
- * disable when SPI is been used
+ * @brief Queues a write, sent on SpiDevFlush() or when the queue is full
+ *
+ * The first queued write takes the bus until the flush, so the batch is
+ * built and sent in one lease. Consecutive writes to the same device
+ * are sent with one configuration check. Writes without select
+ * callback that are contiguous in memory go out as a single transfer.
+ * Blocking and asynchronous calls flush the queue of their SSP first.
+ *
+ * @param[in] 	dev 		Pointer to SPI device
+ * @param[in] 	buffer 		Pointer to data to write. Must stay valid until flushed
+ * @param[in] 	bytes_to_w	Number of bytes to write
+ * @param[in] 	select		Called around this write. May be null
+ * @param[in] 	ctx			Passed to select
+ */
+void SpiDevQueueWrite(spiDevice_t *dev, const void *buffer, uint32_t bytes_to_w,
+		spiSelect_t select, void *ctx);
+
+/**
+ * @brief Sends the queued writes of an SSP module
+ *
+ * @param[in] 	n	 		SSP module number
+ */
+void SpiDevFlush(spiSsp_t n);
+
+/**
+ * @brief Queues a DMA write with the device SPI configuration
+ *
+ * Blocking calls on any device wait for the queued writes first.
+ * SpiDevTryLock fails while asynchronous writes are pending.
+ *
+ * @param[in] 	dev 		Pointer to SPI device
+ * @param[in] 	xfer 		Transfer descriptor, see SpiWriteAsync(). 'cfg' is set here
+ *
+ * @return false if the queue is full, nothing queued
+ */
+bool SpiDevWriteAsync(spiDevice_t *dev, spiTransfer_t *xfer);
+
+/**
+ * @brief Waits until the asynchronous writes are done. The time counts
+ * as blocked in the bus statistics. Takes the bus like a blocking call
+ *
+ * @param[in] 	dev 		Pointer to SPI device
+ */
+void SpiDevWait(spiDevice_t *dev);
+
+/**
+ * @brief Takes the device bus without waiting. For ISR that use SPI
+ *
+ * With the bus taken, the blocking functions can be called from the same
+ * ISR. Release it with SpiDevUnlock().
+ *
+ * @param[in] 	dev 		Pointer to SPI device
+ *
+ * @return false if another context has the bus or a DMA write is pending
+ */
+bool SpiDevTryLock(spiDevice_t *dev);
+
+/**
+ * @brief Releases the bus taken with SpiDevTryLock()
+ *
+ * @param[in] 	dev 		Pointer to SPI device
+ */
+void SpiDevUnlock(spiDevice_t *dev);
+
+/**
+ * @brief Gets the statistics of an SSP bus
+ *
+ * Counters accumulate from power up or the last SpiDevClearStats()
  *
- * @param[in] 	irq 		Pin interrupt number. Range:0-7
+ * @param[in] 	n	 		SSP module number
+ * @param[out]	s	 		Statistics
  */
-void SpiDevSetIrqList(uint8_t irq);
+void SpiDevGetStats(spiSsp_t n, spiBusStats_t *s);
 
 /**
- * @brief Clears the interrupts from the list
- * of interrupts to disable
+ * @brief Clears the statistics of an SSP bus
  *
- * @param[in] 	irq 		Pin interrupt number. Range:0-7
+ * @param[in] 	n	 		SSP module number
  */
-void SpiDevClearIrqList(uint8_t irq);
+void SpiDevClearStats(spiSsp_t n);
 
 /**
  * @brief Makes a 16 bit packet with a byte command(MSB)
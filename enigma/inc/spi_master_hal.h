@@ -41,6 +41,15 @@
 
 #include "drivers_bm_types.h"
 
+/*==================[macros and definitions]=================================*/
+
+/**
+ * @brief Asynchronous transfers that can be queued at once (all SSP modules)
+ */
+#ifndef SPI_QUEUE_SIZE
+#define SPI_QUEUE_SIZE 8
+#endif
+
 /*==================[typedef]================================================*/
 
 /**
@@ -80,6 +89,26 @@ typedef struct {
 	uint32_t clock_freq;		/**< Clock frequency */
 } spiConfig_t;
 
+/**
+ * @brief Asynchronous transfer callback. Runs on the DMA interrupt
+ */
+typedef void (*spiCallback_t)(void *ctx);
+
+/**
+ * @brief Asynchronous write descriptor
+ *
+ * Owned by the caller. The descriptor and its data must not be modified
+ * until 'on_done' was called.
+ */
+typedef struct {
+	spiConfig_t *cfg;			/**< SSP and format used for the transfer */
+	const void *tx;				/**< Data to write, frames of cfg->bits */
+	uint32_t bytes;				/**< Number of bytes to write */
+	spiCallback_t on_start;		/**< Called before the first frame (e.g. chip select low). May be null */
+	spiCallback_t on_done;		/**< Called after the last frame left the bus (e.g. chip select high). May be null */
+	void *ctx;					/**< Passed to both callbacks */
+} spiTransfer_t;
+
 /*==================[external functions declaration]=========================*/
 
 /**
@@ -140,6 +169,42 @@ void SpiRWBlocking(spiSsp_t n, void *buffer_tx,uint8_t *buffer_rx, uint32_t byte
  */
 void SpiTestLoopBack(spiSsp_t n, bool enable);
 
+/**
+ * @brief Queues a write done by DMA. Discards readings
+ *
+ * Transfers run in order, one at a time. The SSP is reconfigured with
+ * xfer->cfg before each transfer if it was not the last configuration used.
+ * Build with SPI_DMA_SIM to replace the DMA by a model that completes
+ * transfers after their bus time (see SpiDmaSimAdvance()), nothing is sent.
+ *
+ * @param[in] 	xfer 		Pointer to transfer descriptor
+ *
+ * @return false if the queue is full (SPI_QUEUE_SIZE), nothing queued
+ */
+bool SpiWriteAsync(spiTransfer_t *xfer);
+
+/**
+ * @brief Checks for queued or running asynchronous transfers
+ *
+ * @return true until the last queued transfer is done
+ */
+bool SpiAsyncBusy(void);
+
+/**
+ * @brief Waits (polling) until all the asynchronous transfers are done
+ */
+void SpiAsyncWait(void);
+
+#if defined(SPI_DMA_SIM)
+/**
+ * @brief Advances the simulated bus time. Completes the transfers
+ * (and starts the next ones) whose bus time elapsed
+ *
+ * @param[in] 	us	 		Elapsed time in microseconds
+ */
+void SpiDmaSimAdvance(uint32_t us);
+#endif
+
 
 #endif /* MODULES_LPC4337_M4_DRIVERS_BM_INC_SPI_MASTER_HAL_H_ */
 
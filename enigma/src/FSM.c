@@ -34,12 +34,17 @@
 #include "PS2Keyboard.h"
 #include "animation.h"
 #include "FSM.h"
+#if defined(MAX7219_TRACE)
+#include "max7219.h"
+#endif
 
 /*=====[Definition macros of private constants]==============================*/
 
 #define NUM_ROTORS 3          /**< Number of rotors in the Enigma machine */
 #define PLUGB_DELAY 500       /**< Delay in milliseconds for plugboard scanning */
 #define ROTOR_ANIM_DELAY 700  /**< Delay in milliseconds for rotor animation */
+#define LETTER_PULSE_MS 1200  /**< Brightness pulse period of the encrypted letter */
+#define KEY_FADE_MS 200       /**< Brightness back to default on a new key */
 
 /** Pins used for data and clock from the keyboard */
 #define IRQ_PIN  T_COL2
@@ -66,6 +71,8 @@ static void FSM_ConfigPB(void);
 static void FSM_ConfigRotor(void);
 static void (*FSM_Behavior[])(void) = { FSM_Encrypt, FSM_ConfigPB, FSM_ConfigRotor };
 
+static void FSM_OnKey(uint16_t c);
+
 static delay_t plugbDelay;      		/**< Delay handler for plugboard scanning */
 static delay_t rotorAnimDelay;			/**< Delay handler for rotor animation */
 static bool_t keyPressed = false;  		/**< Indicates if a key was pressed */
@@ -96,6 +103,10 @@ void FSM_Init(void) {
     RotaryEncoder_Init();
     delayInit(&rotorAnimDelay, 500);
     PS2Keyboard_Init(DATA_PIN, IRQ_PIN);
+#if defined(PS2_USE_SCAN_SET3)
+    PS2Keyboard_UseScanSet3();
+#endif
+    PS2Keyboard_Subscribe(FSM_OnKey, PS2_EVENT_MAKE, 0);
     Animation_Init();
 
     state = ENCRYPT;
@@ -114,6 +125,8 @@ void FSM_Init(void) {
  */
 void FSM_Update(void) {
     Animation_Loading(true);
+    Animation_SetBrightness(ANIM_BRIGHTNESS_DEFAULT);
+    Animation_SetRotorIndicator(0);
     loadAnimDone = false;
 
     if (state == CONFIG_ROTOR && rotorIndex != (NUM_ROTORS - 1)) {
@@ -123,6 +136,13 @@ void FSM_Update(void) {
             rotorIndex = 0;
         } else if (state == ENCRYPT) {
             PS2Keyboard_DisableInt();
+            PS2Keyboard_PrintStats();
+            Animation_PrintStats();
+            Animation_ResetStats();
+#if defined(MAX7219_TRACE)
+            Max7219TraceReport();
+            Max7219TraceReset();
+#endif
         }
         state++;
         state %= 3;
@@ -153,40 +173,55 @@ void FSM_Update(void) {
     }
 }
 
+/**
+ * @brief Handles a key press from the PS/2 keyboard.
+ *
+ * Called by PS2Keyboard_Process() for every make code. Letters are encrypted
+ * using the Enigma machine and the loading animation is started before the
+ * encrypted output is shown.
+ *
+ * @param c Translated key code with its status bits.
+ */
+static void FSM_OnKey(uint16_t c) {
+    uint8_t ch = PS2Keyboard_KeyToChar(c);
+
+    printf("Value ");
+    if (' ' < ch && ch < 0x7F) {
+        printf("%c", ch);
+    } else {
+        printf("%x", c);
+    }
+    printf(" - Status Bits ");
+    printf("%x", c >> 8);
+    printf("  Code ");
+    printf("%x", c & 0xFF);
+
+    if ('a' <= ch && ch <= 'z') {
+        ch -= 'a' - 'A';  // The machine only has capital letters
+    }
+    if ('A' <= ch && ch <= 'Z') {
+        keyPressed = true;
+        loadAnimDone = false;
+        Animation_Loading(true);
+        Animation_Fade(ANIM_BRIGHTNESS_DEFAULT, KEY_FADE_MS);  // Ends the letter pulse
+
+        out = EnigmaAPI_EncryptChar(ch);
+        printf(" - out : %c", out);
+        displayChar = true;
+    }
+
+    printf("\r\n");
+}
+
 /**
  * @brief Encrypts the input using the Enigma machine.
  *
- * This function reads input from the PS/2 keyboard, encrypts it using the Enigma machine,
- * and displays the encrypted output using the animation module.
+ * This function dispatches pending PS/2 key events to FSM_OnKey() and
+ * displays the encrypted output using the animation module.
  */
 static void FSM_Encrypt(void) {
-    if (PS2Keyboard_Available()) {
-        uint16_t c = PS2Keyboard_Read();
-        if (c > 0) {
-            printf("Value ");
-            if ('A' <= c && c <= 'Z') {
-                printf("%c", c);
-            } else {
-                printf("%x", c);
-            }
-            printf(" - Status Bits ");
-            printf("%x", c >> 8);
-            printf("  Code ");
-            printf("%x", c & 0xFF);
-
-            if ('A' <= c && c <= 'Z') {
-                keyPressed = true;
-                loadAnimDone = false;
-                Animation_Loading(true);
-
-                out = EnigmaAPI_EncryptChar(c);
-                printf(" - out : %c", out);
-                displayChar = true;
-            }
+    PS2Keyboard_Process();
 
-            printf("\r\n");
-        }
-    }
     if (!keyPressed) {
         if (!pressMsgDone) {
             pressMsgDone = Animation_ShiftText(encryptMessage, false);
@@ -204,6 +239,7 @@ static void FSM_Encrypt(void) {
     else if (displayChar && loadAnimDone) {
         displayChar = false;
         Animation_DrawCharacter(out);
+        Animation_Pulse(1, ANIM_BRIGHTNESS_MAX, LETTER_PULSE_MS);
     }
 }
 
@@ -233,6 +269,7 @@ static void FSM_ConfigRotor(void) {
         return; // Do not proceed if the rotor number has not been displayed long enough
     } else {
         rotorAnimDone = true;
+        Animation_SetRotorIndicator(rotorIndex + 1);
         Animation_DrawNumber(rotorPos[rotorIndex] + 1);
     }
 
@@ -255,6 +292,8 @@ static void FSM_ConfigRotor(void) {
  * It processes input, performs actions, and updates the state as needed.
  */
 void FSM_Run(void) {
+    Animation_Update();
+
     if (loadAnimDone) {
         (*FSM_Behavior[state])();
     } else {
@@ -17,6 +17,9 @@
 	- Adjusted pin handling and register configuration for NXP LPC4337 architecture.
 	- Improved comments for readability
 	- Added functions `PS2Keyboard_EnableInt()` and `PS2Keyboard_DisableInt()` for manual control of PS/2 interrupt handling.
+	- Added `PS2Keyboard_Subscribe()` and `PS2Keyboard_Process()` to deliver key events to handlers instead of polling.
+	- Added health counters (`PS2Keyboard_GetStats()`) for queue overflows, parity errors, resends and timeouts.
+	- Added optional Scan Code Set 3 mode (`PS2Keyboard_UseScanSet3()`), falling back to Set 2.
 
 	### IMPORTANT:
 	This library has been adapted for use with the EDU-CIAA board and the NXP LPC4337 microcontroller.
@@ -97,7 +100,8 @@
 	### Related files:
 	- **PS2Keyboard.h** -> Contains returned key definitions and accessible mappings.
 	- **PS2KeyCode.h** -> Contains original PS/2 keyboard scancodes used by this library.
-	- **PS2KeyTable.h** -> Provides mapping tables for converting scancodes into ASCII/UTF-8 characters.
+	- **PS2KeyTable.h** -> Provides mapping tables for converting scancodes into key codes.
+	- **PS2KeyLayout.h** -> Key code to character tables for the layout selected at build time.
 
 	### LICENSE:
 	This software is open-source and distributed under the GNU Lesser General Public License (LGPL).
@@ -109,20 +113,29 @@
 #include "PS2Keyboard.h"
 #include "PS2KeyCode.h"
 #include "PS2KeyTable.h"
+#include "PS2KeyLayout.h"
+#include "ring_buffer.h"
 
 /*=====[Definitions of extern global variables]==============================*/
 
 /* References for system configuration */
 extern pinInitGpioLpc4337_t gpioPinsInit[];  // GPIO pin initialization
-extern tick_t tickRateMS;  // System tick rate in milliseconds
 
 // Private function declarations (internal use only)
 static void send_bit(void);
+static void receive_bit(uint8_t);
 static void send_now(uint8_t);
 static int16_t send_next(void);
 static void ps2_reset(void);
 static uint8_t decode_key(uint8_t);
 static void set_lock();
+static int8_t cmd_queue(const ps2Command_t *);
+static void command_pump(void);
+static bool_t command_response(uint8_t);
+static void command_fail(int8_t);
+static bool_t irq_mask(IRQn_Type);
+static void irq_unmask(IRQn_Type, bool_t);
+static void set3_probe_done(int8_t, const uint8_t *, uint8_t, void *);
 
 /**** Constant control functions to flags array
  in translated key code value order  ****/
@@ -159,9 +172,9 @@ volatile uint8_t _ps2mode;
 /*
  * RX Buffers and Variables (Updated via Interrupts)
  */
-volatile uint16_t _rx_buffer[_RX_BUFFER_SIZE];  // Circular buffer for received keyboard data
-volatile uint8_t _head;  // Points to the last written byte in the RX buffer
-uint8_t _tail;           // Points to the last read byte (not modified in IRQ)
+uint16_t _rx_data[_RX_BUFFER_SIZE];  // Storage for received keyboard data (flags << 8 | byte)
+ringBuffer_t _rx_buffer = RING_BUFFER_INIT(_rx_data);  // Pushed by IRQ, popped by translate()
+volatile bool_t _rx_pending;      // Set by IRQ when a complete sequence was saved
 volatile int8_t _bytes_expected;  // Expected bytes in the current transmission
 volatile uint8_t _bitcount;  // Tracks the bit count for received data
 volatile uint8_t _shiftdata; // Stores the received/sent data
@@ -170,9 +183,10 @@ volatile uint8_t _parity;    // Stores parity bit status for validation
 /*
  * TX Buffers and Variables (For Sending Commands to Keyboard)
  */
-volatile uint8_t _tx_buff[_TX_BUFFER_SIZE];  // Buffer for outgoing keyboard commands
-volatile uint8_t _tx_head;        // Write pointer for TX buffer
-volatile uint8_t _tx_tail;        // Read pointer for TX buffer
+uint16_t _tx_data[_TX_BUFFER_SIZE];  // Storage for outgoing keyboard commands
+// Pushed by send_byte(), popped by send_next() from the clock ISR and from
+// command_pump(). Two consumers: the main side masks the clock interrupt
+ringBuffer_t _tx_buff = RING_BUFFER_INIT(_tx_data);
 volatile uint8_t _last_sent;      // Stores the last sent byte in case of resend request
 volatile uint8_t _now_send;       // Holds a byte for immediate transmission
 volatile uint8_t _response_count; // Number of bytes expected in response to the next TX command
@@ -186,9 +200,9 @@ volatile uint8_t _tx_ready;       // TX status flag for managing transmission ty
 /*
  * Output Key Buffering (For Processed Keystrokes)
  */
-uint16_t _key_buffer[_KEY_BUFF_SIZE];  // Circular buffer for translated key events
-uint8_t _key_head;  // Write pointer for the key buffer
-uint8_t _key_tail;  // Read pointer for the key buffer
+uint16_t _key_data[_KEY_BUFF_SIZE];  // Storage for translated key events
+ringBuffer_t _key_buffer = RING_BUFFER_INIT(_key_data);  // Pushed by Available(), popped by Read()
+bool_t _key_stalled = false;  // Scan codes waiting behind a full key queue
 uint8_t _mode = 0; 	// Keyboard Output Mode Flags
 /*
  * _mode flags:
@@ -196,12 +210,78 @@ uint8_t _mode = 0; 	// Keyboard Output Mode Flags
  * Bit 3 - _NO_BREAKS  (0x08): Disables break codes (key release events).
  */
 
+/*
+ * Key Event Handlers (Called from PS2Keyboard_Process)
+ */
+typedef struct {
+    ps2KeyHandler_t handler;  // Function to call, NULL if the slot is free
+    uint8_t events;           // PS2_EVENT_MAKE and/or PS2_EVENT_BREAK
+    uint16_t modifiers;       // Status bits required in the key
+} ps2Subscriber_t;
+
+ps2Subscriber_t _handlers[_MAX_HANDLERS];
+uint8_t _handler_count = 0;   // Registered handlers
+
+/*
+ * Scan Code Set Selection
+ */
+uint8_t _scan_set = 2;         // Set decoded by translate(), 2 (power-up default) or 3
+bool_t _set3_wanted = false;   // PS2Keyboard_UseScanSet3() was called
+static bool_t _rx_response;    // Last translate() result is a keyboard response, not a key
+
+/*
+ * Keyboard Command Queue (main loop only, fed into the TX buffer by command_pump)
+ */
+typedef struct {
+    ps2Command_t cmd;               // Copy of the caller's descriptor
+    uint8_t resp[_CMD_MAX_RESP];    // Response bytes received so far
+    uint8_t resp_count;             // Response bytes received
+    uint8_t resp_total;             // Response bytes expected (ACKs plus cmd.resp_len)
+} ps2QueuedCmd_t;
+
+ps2QueuedCmd_t _cmd_queue[_CMD_QUEUE_SIZE];
+uint8_t _cmd_head = 0;          // Oldest command, incoming responses belong to it
+uint8_t _cmd_count = 0;         // Queued commands, in flight included
+uint8_t _cmd_inflight = 0;      // Commands from the head already in the TX buffer
+tick_t _cmd_started;            // When the head command was sent
+volatile bool_t _cmd_refeed;    // TX buffer flushed by ps2_reset(), send in-flight commands again
+
+/*
+ * Driver Health Counters (queue overflows and high-water marks live in the rings)
+ */
+ps2Stats_t _stats;
+
 /*
  * PS/2 Hardware Pin Configuration
  * (Set during initialization)
  */
 uint8_t PS2_DataPin;     // Data line pin
 uint8_t PS2_IrqPin;      // IRQ line pin
+uint8_t PS2_DataPort;    // GPIO port of the data line (direct register read in ISR)
+uint8_t PS2_DataBit;     // GPIO bit of the data line (direct register read in ISR)
+uint32_t PS2_FrameTimeout; // RIT ticks allowed for one received frame
+
+#if defined(PS2_LATENCY_PROBE)
+/*
+ * Interrupt Latency Probe
+ * The probe pin is high while the clock ISR runs: on a scope, the clock
+ * falling edge to probe rising edge is the entry latency. Without a scope,
+ * the keyboard clock period is steady inside a frame, so a late entry shows
+ * up as one stretched period in the DWT timestamps.
+ */
+#ifndef PS2_PROBE_PIN
+#define PS2_PROBE_PIN LED3
+#endif
+#define PS2_PROBE_GAP_US 200     // Longer edge to edge time: a new frame
+
+uint8_t PS2_ProbePort;           // GPIO port of the probe pin
+uint8_t PS2_ProbeBit;            // GPIO bit of the probe pin
+uint32_t _probe_gap;             // PS2_PROBE_GAP_US in cycles
+uint32_t _probe_last;            // CYCCNT at the previous ISR entry
+uint32_t _probe_min = UINT32_MAX; // Clock period extremes inside a frame, cycles
+uint32_t _probe_max;
+uint32_t _probe_isr_max;         // Longest ISR run, cycles
+#endif
 
 /*
  * Keyboard Lock and Status Variables
@@ -216,12 +296,33 @@ uint8_t PS2_keystatus;         // Stores the current CAPS/Shift/Alt/etc. status
  * @brief Interrupt Service Routine for the PS/2 keyboard external interrupt.
  *
  * This ISR is triggered on each falling edge of the PS/2 clock signal.
- * It handles both receiving and transmitting data:
  * - If in TX mode, calls `send_bit()` to send data.
- * - If in RX mode, reads incoming data bits, performs parity checking,
- *   and stores valid bytes in the receive buffer.
+ * - If in RX mode, samples the data line and passes it to `receive_bit()`.
  */
+#if defined(PS2_LATENCY_PROBE)
+/* Times one clock ISR run from its entry timestamp */
+static void probe_edge(uint32_t entry) {
+    uint32_t period = entry - _probe_last;
+    uint32_t run = DWT->CYCCNT - entry;
+
+    _probe_last = entry;
+    if (period < _probe_gap) {
+        if (period < _probe_min)
+            _probe_min = period;
+        if (period > _probe_max)
+            _probe_max = period;
+    }
+    if (run > _probe_isr_max)
+        _probe_isr_max = run;
+}
+#endif
+
 void GPIO0_IRQHandler(void) {
+#if defined(PS2_LATENCY_PROBE)
+    uint32_t entry = DWT->CYCCNT;
+
+    LPC_GPIO_PORT->B[PS2_ProbePort][PS2_ProbeBit] = 1;
+#endif
     // Check if the interrupt was triggered by the clock pin
     if (Chip_PININT_GetFallStates(LPC_GPIO_PIN_INT) & PININTCH(0)) {
         // Clear the interrupt flag
@@ -231,81 +332,102 @@ void GPIO0_IRQHandler(void) {
         if (_ps2mode & _TX_MODE) {
             send_bit();
         } else {
-            // Receiving mode
-            static tick_t prev_ticks = 0;
-            tick_t now_ticks;
-            uint8_t val, ret;
-
-            val = gpioRead(PS2_DataPin);  // Read data line state
-
-            // Timeout handling for glitches (if a delay exceeds 250ms, reset)
-            now_ticks = tickRead();
-            uint32_t elapsed_ms = (now_ticks - prev_ticks) * tickRateMS;
-            if (elapsed_ms > 250) {
-                _bitcount = 0;
-                _shiftdata = 0;
+            // Read data line state straight from the GPIO byte register
+            receive_bit(LPC_GPIO_PORT->B[PS2_DataPort][PS2_DataBit]);
+        }
+    }
+#if defined(PS2_LATENCY_PROBE)
+    probe_edge(entry);
+    LPC_GPIO_PORT->B[PS2_ProbePort][PS2_ProbeBit] = 0;
+#endif
+}
+
+/**
+ * @brief Processes one received bit of a PS/2 frame.
+ *
+ * Called once per falling clock edge in RX mode. Counts the frame bits,
+ * performs parity checking and stores valid bytes in the receive buffer.
+ *
+ * @param val State of the data line sampled on the clock edge (0 or 1).
+ */
+static void receive_bit(uint8_t val) {
+    uint8_t ret;
+
+    _bitcount++;  // Move to the next bit
+
+    switch (_bitcount) {
+        case 1: // Start bit
+            _parity = 0;
+            _ps2mode |= _PS2_BUSY;  // Mark as busy
+            // Arm frame timeout, RIT_IRQHandler re-syncs if the frame never completes
+            LPC_RITIMER->COUNTER = 0;
+            Chip_RIT_Enable(LPC_RITIMER);
+            break;
+
+        case 2 ... 9: // Data bits (8 bits)
+            _parity += val;         // Update parity calculation
+            _shiftdata >>= 1;       // Shift bits to the right
+            if (val) _shiftdata |= 0x80;  // Store the received bit
+            break;
+
+        case 10: // Parity check bit
+            _parity &= 1;  // Extract LSB (should be 0 for odd parity)
+            if (_parity == val) {
+                _parity = 0xFD;  // Parity error detected
             }
-            prev_ticks = now_ticks;
-
-            _bitcount++;  // Move to the next bit
-
-            switch (_bitcount) {
-                case 1: // Start bit
-                    _parity = 0;
-                    _ps2mode |= _PS2_BUSY;  // Mark as busy
-                    break;
-
-                case 2 ... 9: // Data bits (8 bits)
-                    _parity += val;         // Update parity calculation
-                    _shiftdata >>= 1;       // Shift bits to the right
-                    if (val) _shiftdata |= 0x80;  // Store the received bit
-                    break;
-
-                case 10: // Parity check bit
-                    _parity &= 1;  // Extract LSB (should be 0 for odd parity)
-                    if (_parity == val) {
-                        _parity = 0xFD;  // Parity error detected
-                    }
-                    break;
-
-                case 11: // Stop bit (end of transmission)
-                    if (_parity >= 0xFD) {  // Parity error detected
-                        send_now(PS2_KC_RESEND);  // Request data resend
-                        _tx_ready |= _HANDSHAKE;
-                    } else {  // Data is valid, store in buffer
-                        ret = decode_key(_shiftdata);  // Decode received key
-
-                        if (ret & 0x02) _bytes_expected--;  // Decrease expected bytes
-
-                        if (_bytes_expected <= 0 || (ret & 0x04)) {  // Save received byte
-                            uint8_t next_head = _head + 1;
-                            if (next_head >= _RX_BUFFER_SIZE) next_head = 0;
-
-                            if (next_head != _tail) {  // Ensure buffer does not overflow
-                                _rx_buffer[next_head] = (uint16_t)_shiftdata;
-                                _rx_buffer[next_head] |= ((uint16_t)_ps2mode) << 8;
-                                _head = next_head;
-                            }
-                        }
-
-                        if (ret & 0x10) {  // Special command (ECHO/RESEND)
-                            send_now(_now_send);
-                            _tx_ready |= _HANDSHAKE;
-                        } else if (_bytes_expected <= 0) {  // Reception complete
-                            // Reset state for next byte reception
-                            _ps2mode &= ~(_E0_MODE | _E1_MODE | _WAIT_RESPONSE | _BREAK_KEY);
-                            _bytes_expected = 0;
-                            _ps2mode &= ~_PS2_BUSY;
-                            send_next();  // Check for pending transmissions
-                        }
-                    }
-                    _bitcount = 0;  // Reset for next byte
-                    break;
+            break;
+
+        case 11: // Stop bit (end of transmission)
+            Chip_RIT_Disable(LPC_RITIMER);  // Frame completed in time
+            _bitcount = 0;  // Reset for next byte, before send_now() sets it for a send
+            if (_parity >= 0xFD) {  // Parity error detected
+                _stats.parity_errors++;
+                send_now(PS2_KC_RESEND);  // Request data resend
+                _tx_ready |= _HANDSHAKE;
+            } else {  // Data is valid, store in buffer
+                ret = decode_key(_shiftdata);  // Decode received key
+
+                if (ret & 0x02) _bytes_expected--;  // Decrease expected bytes
+
+                if (_bytes_expected <= 0 || (ret & 0x04)) {  // Save received byte with its flags
+                    RingBuffer_Push(&_rx_buffer, (uint16_t)_shiftdata | ((uint16_t)_ps2mode << 8));
+                    _rx_pending = true;  // Wake up PS2Keyboard_Process()
+                }
 
-                default: // In case of weird error and end of byte reception re-sync
-                    _bitcount = 0;
+                if (ret & 0x10) {  // Special command (ECHO/RESEND)
+                    send_now(_now_send);
+                    _tx_ready |= _HANDSHAKE;
+                } else if (_bytes_expected <= 0) {  // Reception complete
+                    // Reset state for next byte reception
+                    _ps2mode &= ~(_E0_MODE | _E1_MODE | _WAIT_RESPONSE | _BREAK_KEY);
+                    _bytes_expected = 0;
+                    _ps2mode &= ~_PS2_BUSY;
+                    send_next();  // Check for pending transmissions
+                }
             }
-        }
+            break;
+
+        default: // In case of weird error and end of byte reception re-sync
+            _bitcount = 0;
+    }
+}
+
+/**
+ * @brief Interrupt Service Routine for the PS/2 receive frame timeout.
+ *
+ * The RI timer is armed on the start bit of every received frame and stopped
+ * on its stop bit. If it fires, clock edges were lost or a glitch started a
+ * bogus frame, so the bit counter is reset to re-sync on the next start bit.
+ * Runs at the same priority as the clock ISR so it never splits a bit.
+ */
+void RIT_IRQHandler(void) {
+    Chip_RIT_Disable(LPC_RITIMER);
+    Chip_RIT_ClearInt(LPC_RITIMER);
+
+    if (!(_ps2mode & _TX_MODE)) {
+        _stats.frame_timeouts++;
+        _bitcount = 0;
+        _shiftdata = 0;
     }
 }
 
@@ -346,11 +468,13 @@ static uint8_t decode_key(uint8_t value) {
     switch (value) {
         case 0:
         case PS2_KC_OVERRUN:  // Buffer overrun or error, reset everything
+            _stats.kbd_overruns++;
             ps2_reset();
             state = 0x0C;
             break;
 
         case PS2_KC_RESEND:  // Request to resend last sent byte
+            _stats.resend_requests++;
             if (_ps2mode & _LAST_VALID) {
                 _now_send = _last_sent;
                 state = 0x10;  // Indicate command should be sent
@@ -561,12 +685,11 @@ static void send_now(uint8_t command) {
  * @retval -134 If the system is busy and cannot send the byte right now (checked by the interrupt routines later).
  */
 static int16_t send_next(void) {
-    uint8_t i;        	/**< Index to scan the transmission buffer */
-	int16_t val = -1;   /**< Value of the byte to send, initialized to -1 to signal no byte yet */
+    uint16_t val;       /**< Value of the byte to send */
+    uint16_t next;      /**< Following byte, checked for expected responses */
 
     /* Check if the transmission buffer is empty (no data to send) */
-    i = _tx_tail;
-    if (i == _tx_head)
+    if (RingBuffer_IsEmpty(&_tx_buff))
         return -2;      /**< Return -2 indicating empty buffer */
 
     /* Set the command bit in _tx_ready to indicate that another command needs to be sent */
@@ -581,27 +704,16 @@ static int16_t send_next(void) {
         return -134;
 
     /* Only proceed if we're not currently receiving or sending protocol bytes */
-    /* Scan through the buffer to identify the next byte to send and any expected response bytes */
+    /* Take the next byte to send and count the response bytes that follow it */
+    RingBuffer_Pop(&_tx_buff, &val);
     _response_count = 0;
-    do {
-        i++;
-        if (i >= _TX_BUFFER_SIZE)  /**< If we go beyond the buffer size, wrap around */
-            i = 0;
-
-        /* If no byte has been found yet, take the byte from the buffer */
-        if (val == -1)
-            val = _tx_buff[i];
-        else if (_tx_buff[i] != PS2_KEY_IGNORE)
-            break;  /**< Exit the loop as we've found the byte to send */
-        else
-            _response_count++;  /**< If the byte is marked as ignore, increment the response count */
-
-        /* Update the tail pointer to the new position */
-        _tx_tail = i;
-    } while (i != _tx_head);  /**< Keep looping until we reach the head of the buffer */
+    while (RingBuffer_Peek(&_tx_buff, 0, &next) && next == PS2_KEY_IGNORE) {
+        RingBuffer_Pop(&_tx_buff, NULL);
+        _response_count++;  /**< Each ignore byte is one expected response byte */
+    }
 
     /* Now we know which byte to send and how many bytes we are expecting as a response */
-    send_now(val);  /**< Call the send_now function to start transmitting the byte */
+    send_now((uint8_t)val);  /**< Call the send_now function to start transmitting the byte */
 
     return 1;  /**< Return 1 to indicate that the transmission has started or queued */
 }
@@ -625,19 +737,9 @@ static int16_t send_next(void) {
  * @retval -4 If the buffer is full and the byte cannot be written (buffer overrun).
  */
 static int send_byte(uint8_t val) {
-    uint8_t ret;
-
-    /* Calculate the next head position in the circular buffer */
-    ret = _tx_head + 1;
-    if (ret >= _TX_BUFFER_SIZE)  /**< Wrap around to 0 if the end of the buffer is reached */
-        ret = 0;
-
-    /* Check if the buffer is full (head pointer is next to the tail pointer) */
-    if (ret != _tx_tail) {
-        _tx_buff[ret] = val;  /**< Write the byte to the buffer */
-        _tx_head = ret;       /**< Update the head pointer */
+    /* Write the byte unless the buffer is full */
+    if (RingBuffer_Push(&_tx_buff, val))
         return 1;  /**< Return 1 to indicate the byte was successfully written */
-    }
 
     return -4;  /**< Return -4 if the buffer is full and the byte could not be written */
 }
@@ -657,12 +759,12 @@ static int send_byte(uint8_t val) {
  */
 static void ps2_reset(void) {
     /* reset buffers and states */
-    _tx_head = 0;
-    _tx_tail = 0;
+    RingBuffer_Reset(&_tx_buff);
     _tx_ready = 0;
     _response_count = 0;
-    _head = 0;
-    _tail = 0;
+    RingBuffer_Reset(&_rx_buffer);
+    _rx_pending = false;
+    _cmd_refeed = true;  // Commands in flight were flushed with the TX buffer
     _bitcount = 0;
     PS2_keystatus = 0;
     PS2_led_lock = 0;
@@ -672,20 +774,11 @@ static void ps2_reset(void) {
 /**
  * @brief Check the number of available keys in the RX buffer.
  *
- * This function calculates how many bytes (keys) are currently available in the RX buffer
- * by checking the difference between the head and tail pointers. If the buffer is circular,
- * the function properly handles the wraparound by adjusting the calculation.
- *
  * @return The number of available keys in the buffer.
  *         A value of 0 indicates no keys are available.
  */
 static uint8_t key_available() {
-    int8_t i;
-
-    i = _head - _tail;
-    if (i < 0)
-        i += _RX_BUFFER_SIZE;
-    return (uint8_t) i;
+    return RingBuffer_Count(&_rx_buffer);
 }
 
 /**
@@ -708,37 +801,46 @@ static uint8_t key_available() {
  *         - 0 if no valid key is processed, empty buffer, or ignored key.
  */
 static uint16_t translate(void) {
-    uint8_t index, length, data;
-    uint16_t retdata;
+    uint8_t index, data;
+    uint16_t retdata, entry;
 
-    // Get the next character from the buffer
-    // Check if there's anything to fetch
-    index = _tail;
-
-    // If the buffer is empty, return 0
-    if (index == _head)
+    _rx_response = false;
+    // Get the next character from the buffer, return 0 if it is empty
+    if (!RingBuffer_Pop(&_rx_buffer, &entry))
         return 0;
 
-    index++;
-
-    // Wrap around the index if it exceeds buffer size
-    if (index >= _RX_BUFFER_SIZE)
-        index = 0;
-
-    // Update the tail pointer to the new index
-    _tail = index;
-
     // Get the flags byte (break modes, etc.)
-    data = _rx_buffer[index] & 0xFF; // Lower byte for data
-    index = (_rx_buffer[index] & 0xFF00) >> 8; // Upper byte for flags
+    data = entry & 0xFF; // Lower byte for data
+    index = (entry & 0xFF00) >> 8; // Upper byte for flags
 
     // Check if it's a special PAUSE key (E1 mode is enabled)
     if (index & _E1_MODE)
-        return PS2_KEY_PAUSE + _FUNCTION; // Return a specific key code for PAUSE
+        return PS2_FUNCTION | PS2_KEY_PAUSE; // Return a specific key code for PAUSE
+
+    // A keyboard reset (self-test passed) puts it back on set 2
+    if (data == PS2_KC_BAT && _scan_set == 3) {
+        _scan_set = 2;
+        if (_set3_wanted)
+            PS2Keyboard_UseScanSet3();  // Switch again
+    }
+
+    // Responses belong to the oldest queued command
+    if (_cmd_inflight) {
+        if ((index & _WAIT_RESPONSE) && command_response(data))
+            return PS2_KEY_IGNORE;  // Delivered to its callback
+        if (data == PS2_KC_ERROR) {
+            bool_t consumed = (_cmd_queue[_cmd_head].cmd.callback != NULL);
+
+            command_fail(PS2_CMD_ERROR);
+            if (consumed)
+                return PS2_KEY_IGNORE;  // Reported through the callback
+        }
+    }
 
     // Ignore command/response data (not actual key codes)
-    if ((data >= PS2_KC_BAT && data != PS2_KC_LANG1 && data != PS2_KC_LANG2)
-        || (index & _WAIT_RESPONSE))
+    _rx_response = (data >= PS2_KC_BAT && data != PS2_KC_LANG1 && data != PS2_KC_LANG2)
+                   || (index & _WAIT_RESPONSE);
+    if (_rx_response)
         return (uint16_t) data; // Return untranslated command/response data
 
     // Handle the "break" (key release) status
@@ -747,46 +849,21 @@ static uint16_t translate(void) {
     else
         PS2_keystatus &= ~_BREAK;
 
-    // Initialize return data as error code by default
-    retdata = 0;
-
-    // Scan the appropriate key table based on the flags (E0 mode for extended keys)
-    if (index & _E0_MODE) {
-        length = sizeof(extended_key) / sizeof(extended_key[0]); // Size of extended key table
-        for (index = 0; index < length; index++) {
-            #if defined( PS2_REQUIRES_PROGMEM )
-                // If using PROGMEM, read the data from program memory
-                if( data == pgm_read_byte( &extended_key[ index ][ 0 ] ) ) {
-                    retdata = pgm_read_byte( &extended_key[ index ][ 1 ] );
-                }
-            #else
-                if (data == extended_key[index][0]) {
-                    retdata = extended_key[index][1]; // Return the matching key code
-                }
-            #endif
-            if (retdata != 0) break; // Break when a match is found
-        }
-    } else {
-        // For non-extended keys, use the single key table
-        length = sizeof(single_key) / sizeof(single_key[0]);
-        for (index = 0; index < length; index++) {
-            #if defined( PS2_REQUIRES_PROGMEM )
-                // If using PROGMEM, read the data from program memory
-                if( data == pgm_read_byte( &single_key[ index ][ 0 ] ) ) {
-                    retdata = pgm_read_byte( &single_key[ index ][ 1 ] );
-                }
-            #else
-                if (data == single_key[index][0]) {
-                    retdata = single_key[index][1]; // Return the matching key code
-                }
-            #endif
-            if (retdata != 0) break; // Break when a match is found
-        }
-    }
-
-    // If no matching key was found, set retdata to 0 (invalid key)
-    if (index == length)
-        retdata = 0;
+    // Direct lookup in the table selected by the scan set and flags byte (E0 mode for extended keys)
+    // Codes without a mapping read as 0 (invalid key)
+    #if defined( PS2_REQUIRES_PROGMEM )
+        if (_scan_set == 3)
+            retdata = pgm_read_byte( &set3_key[ data ] );
+        else if (index & _E0_MODE)
+            retdata = pgm_read_byte( &extended_key[ data ] );
+        else
+            retdata = pgm_read_byte( &single_key[ data ] );
+    #else
+        if (_scan_set == 3)
+            retdata = set3_key[data];
+        else
+            retdata = (index & _E0_MODE) ? extended_key[data] : single_key[data];
+    #endif
 
     /* Handle the found key codes */
     if (retdata > 0) {
@@ -880,11 +957,229 @@ static uint16_t translate(void) {
  * and if the system is idle, it starts the transmission process.
  */
 static void set_lock() {
-    send_byte(PS2_KC_LOCK);        // Send the lock command (0xED)
-    send_byte(PS2_KEY_IGNORE);     // Wait for ACK (0xFA)
-    send_byte(PS2_led_lock);       // Send the current lock status
-    if (send_byte(PS2_KEY_IGNORE)) // Wait for ACK (0xFA)
-        send_next();               // If idle, start transmission
+    // Lock command (0xED) then the lock status, both ACKed
+    ps2Command_t cmd = { .bytes = { PS2_KC_LOCK, PS2_led_lock }, .len = 2 };
+
+    cmd_queue(&cmd);
+}
+
+
+/**
+ * @brief Queues a keyboard command with the driver defaults filled in.
+ *
+ * @param cmd Command descriptor, copied into the queue.
+ *
+ * @retval 1 If the command was queued.
+ * @retval -4 If the command queue is full.
+ * @retval -5 If the descriptor is invalid or its responses do not fit.
+ */
+static int8_t cmd_queue(const ps2Command_t *cmd) {
+    ps2QueuedCmd_t *q;
+    uint8_t i, acks = 0;
+
+    if (cmd == NULL || cmd->len == 0 || cmd->len > PS2_CMD_MAX_BYTES)
+        return -5;
+    for (i = 0; i < cmd->len; i++)
+        if (cmd->bytes[i] != PS2_KC_ECHO)
+            acks++;  // Every byte but ECHO is answered with ACK
+    if (acks + cmd->resp_len > _CMD_MAX_RESP)
+        return -5;
+    if (_cmd_count >= _CMD_QUEUE_SIZE)
+        return -4;
+
+    q = &_cmd_queue[(_cmd_head + _cmd_count) % _CMD_QUEUE_SIZE];
+    q->cmd = *cmd;
+    if (q->cmd.timeout_ms == 0)
+        q->cmd.timeout_ms = _CMD_TIMEOUT_MS;
+    q->resp_count = 0;
+    q->resp_total = acks + cmd->resp_len;
+    _cmd_count++;
+
+    command_pump();  // Start it now if the keyboard is idle
+    return 1;
+}
+
+
+/**
+ * @brief Disables an interrupt for a main loop critical section.
+ *
+ * @param irq Interrupt to disable.
+ *
+ * @return bool_t Whether it was enabled, NVIC ISER reads back the enable bits.
+ */
+static bool_t irq_mask(IRQn_Type irq) {
+    bool_t enabled = (NVIC->ISER[(uint32_t)irq >> 5] >> ((uint32_t)irq & 0x1F)) & 1;
+
+    NVIC_DisableIRQ(irq);
+    return enabled;
+}
+
+
+/**
+ * @brief Ends a critical section started by irq_mask().
+ *
+ * @param irq     Interrupt to enable again.
+ * @param enabled Value returned by irq_mask(), the interrupt stays off if it was off.
+ */
+static void irq_unmask(IRQn_Type irq, bool_t enabled) {
+    if (enabled)
+        NVIC_EnableIRQ(irq);
+}
+
+
+/**
+ * @brief Feeds queued commands into the TX buffer and checks the timeout.
+ *
+ * Commands are copied in order, each byte followed by a PS2_KEY_IGNORE per
+ * expected response byte, for as long as they fit, so several commands can
+ * be in flight. If the oldest one does not complete in time everything in
+ * flight is flushed and sent again from it.
+ */
+static void command_pump(void) {
+    ps2QueuedCmd_t *q;
+    uint8_t i;
+    bool_t enabled;
+
+    if (_cmd_refeed) {
+        _cmd_refeed = false;
+        _cmd_inflight = 0;
+        if (_cmd_count)
+            _cmd_queue[_cmd_head].resp_count = 0;
+    }
+
+    if (_cmd_inflight && tickRead() - _cmd_started > _cmd_queue[_cmd_head].cmd.timeout_ms)
+        command_fail(PS2_CMD_TIMEOUT);
+
+    while (_cmd_inflight < _cmd_count) {
+        q = &_cmd_queue[(_cmd_head + _cmd_inflight) % _CMD_QUEUE_SIZE];
+        if (_TX_BUFFER_SIZE - RingBuffer_Count(&_tx_buff) < q->cmd.len + q->resp_total)
+            break;  // Rest goes when the keyboard has answered
+
+        for (i = 0; i < q->cmd.len; i++) {
+            send_byte(q->cmd.bytes[i]);
+            if (q->cmd.bytes[i] != PS2_KC_ECHO)
+                send_byte(PS2_KEY_IGNORE);  // Wait for ACK (0xFA)
+        }
+        for (i = 0; i < q->cmd.resp_len; i++)
+            send_byte(PS2_KEY_IGNORE);      // Wait for each extra response byte
+
+        if (_cmd_inflight == 0)
+            _cmd_started = tickRead();
+        _cmd_inflight++;
+        enabled = irq_mask(PIN_INT0_IRQn);  // The clock ISR also pops _tx_buff
+        send_next();  // If idle, start transmission
+        irq_unmask(PIN_INT0_IRQn, enabled);
+    }
+}
+
+
+/**
+ * @brief Completes the oldest command and calls its callback.
+ *
+ * @param status PS2_CMD_OK, PS2_CMD_TIMEOUT or PS2_CMD_ERROR.
+ */
+static void command_done(int8_t status) {
+    ps2QueuedCmd_t *q = &_cmd_queue[_cmd_head];
+    ps2CmdCallback_t callback = q->cmd.callback;
+    void *ctx = q->cmd.ctx;
+    uint8_t resp[_CMD_MAX_RESP];
+    uint8_t i, len = q->resp_count;
+
+    for (i = 0; i < len; i++)
+        resp[i] = q->resp[i];  // Slot can be reused by the callback
+
+    _cmd_head = (_cmd_head + 1) % _CMD_QUEUE_SIZE;
+    _cmd_count--;
+    if (_cmd_inflight)
+        _cmd_inflight--;
+    _cmd_started = tickRead();  // Next command's response time starts now
+
+    if (status != PS2_CMD_OK)
+        _stats.cmd_failures++;
+    if (callback != NULL)
+        callback(status, resp, len, ctx);
+}
+
+
+/**
+ * @brief Sends the oldest command again or gives it up.
+ *
+ * Flushes the TX buffer and the protocol state first, so the commands that
+ * were in flight behind it are sent again too.
+ *
+ * @param status Status reported if no retries are left.
+ */
+static void command_fail(int8_t status) {
+    ps2QueuedCmd_t *q = &_cmd_queue[_cmd_head];
+    bool_t enabled = irq_mask(PIN_INT0_IRQn);
+
+    RingBuffer_Reset(&_tx_buff);
+    _tx_ready = 0;
+    _response_count = 0;
+    _bytes_expected = 0;
+    _bitcount = 0;
+    _ps2mode &= ~(_TX_MODE | _WAIT_RESPONSE | _PS2_BUSY);
+    // Release the lines in case a send was cut short
+    gpioConfig(PS2_DataPin, GPIO_INPUT_PULLUP);
+    gpioConfig(PS2_IrqPin, GPIO_INPUT_PULLUP);
+    NVIC_ClearPendingIRQ(PIN_INT0_IRQn + 0);
+    irq_unmask(PIN_INT0_IRQn, enabled);
+
+    _cmd_inflight = 0;
+    if (q->cmd.retries) {
+        q->cmd.retries--;
+        q->resp_count = 0;
+        _stats.cmd_retries++;
+    } else {
+        command_done(status);
+    }
+    // command_pump() sends them again
+}
+
+
+/**
+ * @brief Stores a response byte for the oldest command.
+ *
+ * @param data Response byte from the keyboard.
+ *
+ * @return bool_t true if the command has a callback (byte consumed), false
+ *         if the byte should go to the key buffer as before.
+ */
+static bool_t command_response(uint8_t data) {
+    ps2QueuedCmd_t *q = &_cmd_queue[_cmd_head];
+    bool_t consumed = (q->cmd.callback != NULL);
+
+    if (q->resp_count < _CMD_MAX_RESP)
+        q->resp[q->resp_count] = data;
+    if (++q->resp_count >= q->resp_total)
+        command_done(PS2_CMD_OK);
+    return consumed;
+}
+
+
+/**
+ * @brief Completion of the set id read back after a scan code set 3 switch.
+ *
+ * Decoding moves to the set 3 table only when the keyboard confirms it.
+ * Anything else means set 3 is not supported, so set 2 is selected again
+ * in case the keyboard took the switch halfway.
+ *
+ * @param status Command status.
+ * @param resp   ACK, ACK, set id.
+ * @param len    Number of response bytes.
+ * @param ctx    Unused.
+ */
+static void set3_probe_done(int8_t status, const uint8_t *resp, uint8_t len, void *ctx) {
+    ps2Command_t set2 = { .bytes = { PS2_KC_SCANCODE, 2 }, .len = 2, .retries = _CMD_RETRIES };
+    uint8_t id = len ? resp[len - 1] : 0;
+
+    (void) ctx;
+    if (status == PS2_CMD_OK && (id == 3 || id == 0x3F)) {  // 0x3F is the translated set 3 id
+        _scan_set = 3;
+    } else {
+        _scan_set = 2;
+        cmd_queue(&set2);
+    }
 }
 
 
@@ -899,11 +1194,10 @@ static void set_lock() {
  * retrieved using functions that process incoming data.
  */
 void PS2Keyboard_Echo(void) {
-    send_byte(PS2_KC_ECHO);             // Send the ECHO command (0xEE)
+    // ECHO (0xEE) is answered with ECHO instead of ACK
+    ps2Command_t cmd = { .bytes = { PS2_KC_ECHO }, .len = 1, .resp_len = 1, .retries = _CMD_RETRIES };
 
-    // Wait for a response; if the keyboard is idle, start transmission
-    if ((send_byte(PS2_KEY_IGNORE)))
-        send_next();
+    cmd_queue(&cmd);
 }
 
 
@@ -917,11 +1211,10 @@ void PS2Keyboard_Echo(void) {
  * The function handles waiting for the acknowledgment and response.
  */
 void PS2Keyboard_ReadID(void) {
-    send_byte(PS2_KC_READID);           // Send the "Read ID" command (0xF2)
-    send_byte(PS2_KEY_IGNORE);          // Wait for ACK (0xFA)
-    send_byte(PS2_KEY_IGNORE);          // Wait for the first byte of ID
-    if ((send_byte(PS2_KEY_IGNORE)))    // Wait for the second byte of ID
-        send_next();                    // If idle, start transmission
+    // "Read ID" (0xF2), ACK then two ID bytes
+    ps2Command_t cmd = { .bytes = { PS2_KC_READID }, .len = 1, .resp_len = 2, .retries = _CMD_RETRIES };
+
+    cmd_queue(&cmd);
 }
 
 
@@ -940,12 +1233,61 @@ void PS2Keyboard_ReadID(void) {
  * The returned scan code set identifier is stored in the keyboard buffer.
  */
 void PS2Keyboard_GetScanCodeSet(void) {
-    send_byte(PS2_KC_SCANCODE);         // Send "Get/Set Scan Code Set" command (0xF0)
-    send_byte(PS2_KEY_IGNORE);          // Wait for ACK (0xFA)
-    send_byte(0);                       // Send data byte 0 (request current set)
-    send_byte(PS2_KEY_IGNORE);          // Wait for ACK (0xFA)
-    if ((send_byte(PS2_KEY_IGNORE)))    // Wait for scan code set identifier
-        send_next();                    // If idle, start transmission
+    // "Get/Set Scan Code Set" (0xF0) with 0 requests the current set, both ACKed, then the set id
+    ps2Command_t cmd = { .bytes = { PS2_KC_SCANCODE, 0 }, .len = 2, .resp_len = 1, .retries = _CMD_RETRIES };
+
+    cmd_queue(&cmd);
+}
+
+
+/**
+ * @brief Switches the keyboard to scan code set 3 with all keys make/break.
+ *
+ * Queues "select set 3", "all keys make/break" and "read scan code set".
+ * translate() keeps decoding set 2 until set3_probe_done() sees set 3 read
+ * back, so keyboards without set 3 support simply stay on set 2. The switch
+ * is repeated automatically after a keyboard reset.
+ */
+void PS2Keyboard_UseScanSet3(void) {
+    ps2Command_t select = { .bytes = { PS2_KC_SCANCODE, 3 }, .len = 2, .retries = _CMD_RETRIES };
+    ps2Command_t mkbrk = { .bytes = { PS2_KC_ALL_MKBRK }, .len = 1, .retries = _CMD_RETRIES };
+    ps2Command_t readback = { .bytes = { PS2_KC_SCANCODE, 0 }, .len = 2, .resp_len = 1,
+                              .retries = _CMD_RETRIES, .callback = set3_probe_done };
+
+    _set3_wanted = true;
+    cmd_queue(&select);
+    cmd_queue(&mkbrk);
+    cmd_queue(&readback);
+}
+
+
+/**
+ * @brief Returns the scan code set currently being decoded.
+ *
+ * @return uint8_t 2, or 3 once PS2Keyboard_UseScanSet3() was confirmed.
+ */
+uint8_t PS2Keyboard_ActiveScanSet(void) {
+    return _scan_set;
+}
+
+// Converts a key code to a character of the build layout (see PS2Keyboard.h for details)
+uint8_t PS2Keyboard_KeyToChar(uint16_t key) {
+    uint8_t code = key & 0xFF;
+    uint8_t state;
+
+    if ((key & (PS2_BREAK | PS2_CTRL | PS2_ALT | PS2_GUI)) || code >= _LAYOUT_SIZE)
+        return 0;
+
+    if (key & PS2_ALT_GR)
+        state = _LAYOUT_ALT_GR;
+    else
+        state = ((key & PS2_SHIFT) ? _LAYOUT_SHIFT : 0) | ((key & PS2_CAPS) ? _LAYOUT_CAPS : 0);
+
+#if defined( PS2_REQUIRES_PROGMEM )
+    return pgm_read_byte(&layout_char[state][code]);
+#else
+    return layout_char[state][code];
+#endif
 }
 
 
@@ -1036,10 +1378,11 @@ void PS2Keyboard_SetNoRepeat(uint8_t data) {
  * to match the keyboard’s state after reset.
  */
 void PS2Keyboard_ResetKey() {
-    send_byte( PS2_KC_RESET );         	// Send reset command
-    send_byte( PS2_KEY_IGNORE );       	// Wait for ACK
-    if ( (send_byte( PS2_KEY_IGNORE)) ) // Wait for self-test result (0xAA or 0xFC)
-        send_next();                  	// If idle, start transmission
+    // Reset command, ACK then the self-test result (0xAA or 0xFC)
+    ps2Command_t cmd = { .bytes = { PS2_KC_RESET }, .len = 1, .resp_len = 1,
+                         .timeout_ms = _CMD_RESET_TIMEOUT_MS };
+
+    cmd_queue(&cmd);
     // Reset internal LED lock and key status
     PS2_led_lock = 0;
     PS2_keystatus = 0;
@@ -1073,12 +1416,11 @@ int PS2Keyboard_Typematic(uint8_t rate, uint8_t delay) {
     if (rate > 31 || delay > 3)
         return -5;  // Return error if parameters are out of range
 
-    send_byte(PS2_KC_RATE);               // Send the command to set typematic rate and delay
-    send_byte(PS2_KEY_IGNORE);            // Wait for ACK (Acknowledgement)
-    send_byte((delay << 5) + rate);       // Send the delay and rate values
-    if ((send_byte(PS2_KEY_IGNORE)))      // Wait for ACK (Acknowledgement)
-        send_next();                      // If idle, start the transmission
+    // Typematic command then the delay and rate values, both ACKed
+    ps2Command_t cmd = { .bytes = { PS2_KC_RATE, (uint8_t)((delay << 5) + rate) }, .len = 2,
+                         .retries = _CMD_RETRIES };
 
+    cmd_queue(&cmd);
     return 0;  // Return success
 }
 
@@ -1092,36 +1434,33 @@ int PS2Keyboard_Typematic(uint8_t rate, uint8_t delay) {
  *
  * @return uint8_t The count of available processed key codes in the buffer, or 0 if the buffer is empty.
  *
- * @note The function uses a ring buffer approach, where when the pointers match, the buffer is considered empty.
  */
 uint8_t PS2Keyboard_Available() {
-    int8_t i, idx;
     uint16_t data;
 
-    // Check the output queue for available keys
-    i = _key_head - _key_tail;
-    if (i < 0)
-        i += _KEY_BUFF_SIZE;
-
-    // Process keys if the buffer is not full
-    while (i < (_KEY_BUFF_SIZE - 1)) {
+    // Process keys while the output buffer is not full
+    while (!RingBuffer_IsFull(&_key_buffer)) {
         if (key_available()) {  // Check if there are more keys to process
             data = translate();  // Get the next translated key
             if (data == 0)  // If the buffer is empty, exit the loop
                 break;
             if ((data & 0xFF) != PS2_KEY_IGNORE && (data & 0xFF) > 0) {
-                idx = _key_head + 1;  // Point to the next space in the buffer
-                if (idx >= _KEY_BUFF_SIZE)  // Loop back to the start if necessary
-                    idx = 0;
-                _key_buffer[idx] = data;  // Save the data to the buffer
-                _key_head = idx;  // Update the head pointer
-                i++;  // Update the available count
+                RingBuffer_Push(&_key_buffer, data);  // Save the data to the buffer
             }
         } else {
             break;  // Exit if no more keys are coming in
         }
     }
-    return (uint8_t)i;
+    // Nothing is lost yet, the scan codes wait in the RX queue: count each stall once
+    if (RingBuffer_IsFull(&_key_buffer) && key_available()) {
+        if (!_key_stalled)
+            _stats.key_stalls++;
+        _key_stalled = true;
+    } else {
+        _key_stalled = false;
+    }
+    command_pump();  // Complete, time out or start queued commands
+    return RingBuffer_Count(&_key_buffer);
 }
 
 /**
@@ -1135,26 +1474,172 @@ uint8_t PS2Keyboard_Available() {
  */
 uint16_t PS2Keyboard_Read()
 {
-    uint16_t result;
-    uint8_t idx;
-
-    // Check if a key is available in the buffer
-    result = PS2Keyboard_Available();
-    if (result)
-    {
-        idx = _key_tail;  // Get current read index
-        idx++;
-        if (idx >= _KEY_BUFF_SIZE)  // Wrap around if end of buffer is reached
-            idx = 0;
-
-        _key_tail = idx;  // Update buffer read index
-        result = _key_buffer[idx];  // Retrieve the last key read
-    }
+    uint16_t result = 0;
+
+    // Retrieve the oldest key if one is available in the buffer
+    if (PS2Keyboard_Available())
+        RingBuffer_Pop(&_key_buffer, &result);
 
     return result;
 }
 
 
+/**
+ * @brief Registers a handler for translated key events.
+ *
+ * @param handler   Function to call with each matching key.
+ * @param events    PS2_EVENT_MAKE, PS2_EVENT_BREAK or PS2_EVENT_ALL.
+ * @param modifiers Status bits that must all be set in the key, 0 for any.
+ *
+ * @return bool_t true if registered, false if the handler table is full.
+ */
+bool_t PS2Keyboard_Subscribe(ps2KeyHandler_t handler, uint8_t events, uint16_t modifiers) {
+    uint8_t i;
+
+    if (handler == NULL)
+        return false;
+
+    for (i = 0; i < _MAX_HANDLERS; i++) {
+        if (_handlers[i].handler == NULL) {
+            _handlers[i].events = events;
+            _handlers[i].modifiers = modifiers;
+            _handlers[i].handler = handler;
+            _handler_count++;
+            return true;
+        }
+    }
+    return false;  // No free slot
+}
+
+/**
+ * @brief Removes a handler registered with PS2Keyboard_Subscribe().
+ *
+ * @param handler Function to remove.
+ */
+void PS2Keyboard_Unsubscribe(ps2KeyHandler_t handler) {
+    uint8_t i;
+
+    for (i = 0; i < _MAX_HANDLERS; i++) {
+        if (handler != NULL && _handlers[i].handler == handler) {
+            _handlers[i].handler = NULL;
+            _handler_count--;
+        }
+    }
+}
+
+/**
+ * @brief Delivers pending key events to the registered handlers.
+ *
+ * Translation runs here, in the caller's context, only after the interrupt
+ * flagged a completed sequence. Without handlers the keys are left for
+ * PS2Keyboard_Available()/PS2Keyboard_Read().
+ */
+void PS2Keyboard_Process(void) {
+    uint16_t data;
+    uint8_t i, event;
+    bool_t handled, subscribed;
+
+    if (_handler_count == 0) {
+        PS2Keyboard_Available();  // Collects responses, keys stay for PS2Keyboard_Read()
+        return;
+    }
+
+    if (!_rx_pending) {
+        command_pump();
+        return;
+    }
+    _rx_pending = false;  // Cleared first so a sequence arriving now is not missed
+
+    while (key_available()) {
+        data = translate();  // Get the next translated key
+        if ((data & 0xFF) == PS2_KEY_IGNORE || (data & 0xFF) == 0)
+            continue;
+        if (_rx_response)
+            continue;  // BAT after a hot plug, RESEND, ECHO...: not key events
+
+        event = (data & PS2_BREAK) ? PS2_EVENT_BREAK : PS2_EVENT_MAKE;
+        handled = false;
+        subscribed = false;
+        for (i = 0; i < _MAX_HANDLERS; i++) {
+            if (_handlers[i].handler != NULL && (_handlers[i].events & event)) {
+                subscribed = true;
+                if ((data & _handlers[i].modifiers) == _handlers[i].modifiers) {
+                    _handlers[i].handler(data);
+                    handled = true;
+                }
+            }
+        }
+        if (subscribed && !handled)
+            _stats.keys_unhandled++;  // Event type wanted, but no modifier filter matched
+    }
+    command_pump();
+}
+
+// Queues a command for the keyboard (see PS2Keyboard.h for details)
+int8_t PS2Keyboard_SendCommand(const ps2Command_t *cmd) {
+    return cmd_queue(cmd);
+}
+
+// Copies the driver health counters (see PS2Keyboard.h for details)
+void PS2Keyboard_GetStats(ps2Stats_t *stats) {
+    // The clock and RIT ISRs count too, hold them off for a consistent copy
+    bool_t clock = irq_mask(PIN_INT0_IRQn);
+    bool_t rit = irq_mask(RITIMER_IRQn);
+
+    *stats = _stats;
+    stats->rx_overflows = _rx_buffer.overflows;
+    stats->tx_overflows = _tx_buff.overflows;
+    stats->rx_high_water = _rx_buffer.high_water;
+    stats->tx_high_water = _tx_buff.high_water;
+    stats->key_high_water = _key_buffer.high_water;
+#if defined(PS2_LATENCY_PROBE)
+    uint32_t cycles_us = SystemCoreClock / 1000000;
+
+    stats->clk_min_us = (_probe_min == UINT32_MAX) ? 0 : _probe_min / cycles_us;
+    stats->clk_max_us = _probe_max / cycles_us;
+    stats->isr_max_cycles = _probe_isr_max;
+#endif
+    irq_unmask(RITIMER_IRQn, rit);
+    irq_unmask(PIN_INT0_IRQn, clock);
+}
+
+// Clears all driver health counters (see PS2Keyboard.h for details)
+void PS2Keyboard_ResetStats(void) {
+    bool_t clock = irq_mask(PIN_INT0_IRQn);  // Same as PS2Keyboard_GetStats()
+    bool_t rit = irq_mask(RITIMER_IRQn);
+
+    _stats = (ps2Stats_t){ 0 };
+    RingBuffer_ClearStats(&_rx_buffer);
+    RingBuffer_ClearStats(&_tx_buff);
+    RingBuffer_ClearStats(&_key_buffer);
+#if defined(PS2_LATENCY_PROBE)
+    _probe_min = UINT32_MAX;
+    _probe_max = 0;
+    _probe_isr_max = 0;
+#endif
+    irq_unmask(RITIMER_IRQn, rit);
+    irq_unmask(PIN_INT0_IRQn, clock);
+}
+
+// Prints the driver health counters (see PS2Keyboard.h for details)
+void PS2Keyboard_PrintStats(void) {
+    ps2Stats_t s;
+
+    PS2Keyboard_GetStats(&s);
+    printf("PS/2 queues: RX %u/%u lost %u, TX %u/%u lost %u, KEY %u/%u stalled %u\r\n",
+           s.rx_high_water, _RX_BUFFER_SIZE, s.rx_overflows,
+           s.tx_high_water, _TX_BUFFER_SIZE, s.tx_overflows,
+           s.key_high_water, _KEY_BUFF_SIZE, s.key_stalls);
+    printf("PS/2 errors: parity %u, resend req %u, timeouts %u, kbd overruns %u, unhandled keys %u\r\n",
+           s.parity_errors, s.resend_requests, s.frame_timeouts,
+           s.kbd_overruns, s.keys_unhandled);
+    printf("PS/2 commands: retries %u, failed %u\r\n", s.cmd_retries, s.cmd_failures);
+#if defined(PS2_LATENCY_PROBE)
+    printf("PS/2 clock: period %u-%u us in frame, ISR max %u cycles\r\n",
+           s.clk_min_us, s.clk_max_us, s.isr_max_cycles);
+#endif
+}
+
 /**
  * @brief Enables the PS/2 interrupt after resetting the state machine.
  *
@@ -1192,12 +1677,24 @@ void PS2Keyboard_Init(gpioMap_t dataPin, gpioMap_t irqPin) {
     /* Store pin configuration */
     PS2_DataPin = dataPin;
     PS2_IrqPin = irqPin;
+    PS2_DataPort = gpioPinsInit[PS2_DataPin].gpio.port;
+    PS2_DataBit = gpioPinsInit[PS2_DataPin].gpio.pin;
 
     /* --- GPIO Configuration --- */
     // Configure Data and Clock pins as input with pull-up resistors
     gpioInit(PS2_DataPin, GPIO_INPUT_PULLUP);
     gpioInit(PS2_IrqPin, GPIO_INPUT_PULLUP);
 
+#if defined(PS2_LATENCY_PROBE)
+    gpioInit(PS2_PROBE_PIN, GPIO_OUTPUT);
+    gpioWrite(PS2_PROBE_PIN, OFF);
+    PS2_ProbePort = gpioPinsInit[PS2_PROBE_PIN].gpio.port;
+    PS2_ProbeBit = gpioPinsInit[PS2_PROBE_PIN].gpio.pin;
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;  // Cycle counter for the entry timestamps
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    _probe_gap = PS2_PROBE_GAP_US * (SystemCoreClock / 1000000);
+#endif
+
     /* --- Interrupt Configuration --- */
     // Associate the selected GPIO pin with the interrupt channel
     Chip_SCU_GPIOIntPinSel( 0, gpioPinsInit[PS2_IrqPin].gpio.port,
@@ -1214,9 +1711,22 @@ void PS2Keyboard_Init(gpioMap_t dataPin, gpioMap_t irqPin) {
 
     /* --- NVIC (Nested Vectored Interrupt Controller) Configuration --- */
     // Define interrupt priority level (lower values = higher priority)
-    const uint8_t PS2_INTERRUPT_PRIORITY = 7;
+    // Above the display DMA (6) and gray scale timer (7): a late clock edge loses a bit
+    const uint8_t PS2_INTERRUPT_PRIORITY = 5;
 
     NVIC_SetPriority( PIN_INT0_IRQn + 0, PS2_INTERRUPT_PRIORITY );
     NVIC_ClearPendingIRQ( PIN_INT0_IRQn + 0 );
     NVIC_EnableIRQ( PIN_INT0_IRQn + 0 );
+
+    /* --- Frame timeout (RI timer, one-shot per received frame) --- */
+    PS2_FrameTimeout = (Chip_Clock_GetRate(CLK_MX_RITIMER) / 1000000) * _FRAME_TIMEOUT_US;
+    Chip_RIT_Init(LPC_RITIMER);
+    Chip_RIT_Disable(LPC_RITIMER);
+    Chip_RIT_SetCOMPVAL(LPC_RITIMER, PS2_FrameTimeout);
+    Chip_RIT_EnableCTRL(LPC_RITIMER, RIT_CTRL_ENCLR);  // Counter clears on match
+
+    // Same priority as the clock ISR so neither can preempt the other
+    NVIC_SetPriority( RITIMER_IRQn, PS2_INTERRUPT_PRIORITY );
+    NVIC_ClearPendingIRQ( RITIMER_IRQn );
+    NVIC_EnableIRQ( RITIMER_IRQn );
 }
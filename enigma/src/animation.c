@@ -13,37 +13,349 @@
  * @version 1.0
  */
 
+#include "animation.h"
 #include "led_matrix.h"
 #include "font8x8_basic.h"
  
 #define CHAR_TO_IMAGE64x1_ROW( ROW, VALUE ) ( ((uint64_t) VALUE) << ((7 - ROW) * 8) )
- 
+
+/** Matrix mounting in degrees clockwise, the glyph tables are built for it */
+#ifndef ANIMATION_ROTATION
+#define ANIMATION_ROTATION 270
+#endif
+
+/** Scrolled text: blank columns after each character and width of a space */
+#ifndef ANIMATION_KERNING
+#define ANIMATION_KERNING 1
+#endif
+#ifndef ANIMATION_SPACE_WIDTH
+#define ANIMATION_SPACE_WIDTH 3
+#endif
+/* Build with ANIMATION_FIXED_FONT to scroll every character as 8 columns */
+
+/** Image pre-rotated at compile time, ready for MatrixSetRawImage */
+#define GLYPH( IMG ) MATRIX_RAW_IMAGE( IMG, ANIMATION_ROTATION ),
+/** Image kept in led-matrix-editor format, for the compositor layers */
+#define SPRITE( IMG ) (IMG),
+
+/** Columns of panel 0 from the left of the chain, see MatrixBlit() */
+#define PANEL0_X ((MATRIX_PANELS - 1) * MATRIX_SIZE)
+/** Second digit of a number, right half of the panel */
+#define DIGIT_SPACING 4
+
 /*=====[Character Font Definitions]==========================================*/
 
-/** Font for 5x3 pixel numbers */
-const uint8_t font5x3_numbers[10][8] = {
-    {0x00, 0xe0, 0xa0, 0xa0, 0xa0, 0xe0, 0x00, 0x00}, // 0
-    {0x00, 0xc0, 0x40, 0x40, 0x40, 0xe0, 0x00, 0x00}, // 1
-    {0x00, 0xe0, 0x20, 0xe0, 0x80, 0xe0, 0x00, 0x00}, // 2
-    {0x00, 0xe0, 0x20, 0x60, 0x20, 0xe0, 0x00, 0x00}, // 3
-    {0x00, 0xa0, 0xa0, 0xe0, 0x20, 0x20, 0x00, 0x00}, // 4
-    {0x00, 0xe0, 0x80, 0xe0, 0x20, 0xe0, 0x00, 0x00}, // 5
-    {0x00, 0xe0, 0x80, 0xe0, 0xa0, 0xe0, 0x00, 0x00}, // 6
-    {0x00, 0xe0, 0x20, 0x60, 0x20, 0x20, 0x00, 0x00}, // 7
-    {0x00, 0xe0, 0xa0, 0xe0, 0xa0, 0xe0, 0x00, 0x00}, // 8
-    {0x00, 0xe0, 0xa0, 0xe0, 0x20, 0x20, 0x00, 0x00}  // 9
-};
+/*
+ * Glyph images in led-matrix-editor format, top row in the high byte.
+ * Only what the machine shows is here: the letters are the A-Z rows of
+ * font8x8_ib8x8u, other characters are still drawn from the full font.
+ */
+
+/** Letters A-Z */
+#define LETTER_IMAGES( X ) \
+        X(0x3078CCCCFCCCCC00ULL) /* A */ \
+        X(0xFC66667C6666FC00ULL) /* B */ \
+        X(0x3C66C0C0C0663C00ULL) /* C */ \
+        X(0xF86C6666666CF800ULL) /* D */ \
+        X(0xFE6268786862FE00ULL) /* E */ \
+        X(0xFE6268786860F000ULL) /* F */ \
+        X(0x3C66C0C0CE663E00ULL) /* G */ \
+        X(0xCCCCCCFCCCCCCC00ULL) /* H */ \
+        X(0x7830303030307800ULL) /* I */ \
+        X(0x1E0C0C0CCCCC7800ULL) /* J */ \
+        X(0xE6666C786C66E600ULL) /* K */ \
+        X(0xF06060606266FE00ULL) /* L */ \
+        X(0xC6EEFEFED6C6C600ULL) /* M */ \
+        X(0xC6E6F6DECEC6C600ULL) /* N */ \
+        X(0x386CC6C6C66C3800ULL) /* O */ \
+        X(0xFC66667C6060F000ULL) /* P */ \
+        X(0x78CCCCCCDC781C00ULL) /* Q */ \
+        X(0xFC66667C6C66E600ULL) /* R */ \
+        X(0x78CCE0701CCC7800ULL) /* S */ \
+        X(0xFCB4303030307800ULL) /* T */ \
+        X(0xCCCCCCCCCCCCFC00ULL) /* U */ \
+        X(0xCCCCCCCCCC783000ULL) /* V */ \
+        X(0xC6C6C6D6FEEEC600ULL) /* W */ \
+        X(0xC6C66C38386CC600ULL) /* X */ \
+        X(0xCCCCCC7830307800ULL) /* Y */ \
+        X(0xFEC68C183266FE00ULL) /* Z */
+
+/** Font for 5x3 pixel numbers, drawn on the left half */
+#define NUMBER_IMAGES( X ) \
+        X(0x00E0A0A0A0E00000ULL) /* 0 */ \
+        X(0x00C0404040E00000ULL) /* 1 */ \
+        X(0x00E020E080E00000ULL) /* 2 */ \
+        X(0x00E0206020E00000ULL) /* 3 */ \
+        X(0x00A0A0E020200000ULL) /* 4 */ \
+        X(0x00E080E020E00000ULL) /* 5 */ \
+        X(0x00E080E0A0E00000ULL) /* 6 */ \
+        X(0x00E0206020200000ULL) /* 7 */ \
+        X(0x00E0A0E0A0E00000ULL) /* 8 */ \
+        X(0x00E0A0E020200000ULL) /* 9 */
 
 /** Font for Roman numerals */
-const uint8_t RomanNumbers[3][8] = {
-    {0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18}, // I
-    {0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66}, // II
-    {0xDB, 0xDB, 0xDB, 0xDB, 0xDB, 0xDB, 0xDB, 0xDB}  // III
+#define ROMAN_IMAGES( X ) \
+        X(0x1818181818181818ULL) /* I */ \
+        X(0x6666666666666666ULL) /* II */ \
+        X(0xDBDBDBDBDBDBDBDBULL) /* III */
+
+static const uint64_t letterGlyphs[26] = { LETTER_IMAGES( GLYPH ) };
+static const uint64_t numberGlyphs[10] = { NUMBER_IMAGES( SPRITE ) };
+static const uint64_t romanGlyphs[3] = { ROMAN_IMAGES( SPRITE ) };
+
+/** Rotor indicator, one 2 column slot per rotor on the bottom row */
+#define INDICATOR_SLOT( ROTOR ) ((uint64_t) (0xC0 >> (3 * ((ROTOR) - 1))))
+#define INDICATOR_MASK 0xFFULL
+
+/*=====[Animation Clips]=====================================================*/
+
+/** Waiting for a key */
+static const animFrame_t waitInputFrames[] = {
+        { 0x1054381000000038ULL, 180 },
+        { 0x1010543810000038ULL, 180 },
+        { 0x1010105438100038ULL, 180 },
+        { 0x0010105438100038ULL, 180 },
+        { 0x000010105438107cULL, 180 },
+        { 0x00001010543810feULL, 180 },
 };
 
+/** Spinning bar, two turns */
+static const animFrame_t loadingFrames[] = {
+        { 0x0018181818181800ULL, 100 },
+        { 0x0002040810204000ULL, 100 },
+        { 0x0000007ffe000000ULL, 100 },
+        { 0x0040201008040200ULL, 100 },
+};
+
+static const animClip_t waitInputClip = ANIM_CLIP( waitInputFrames, ANIM_LOOP );
+static const animClip_t loadingClip = ANIM_CLIP( loadingFrames, 2 );
+
+#if defined(MATRIX_GRAY_PLANES)
+/** Levels of the loading bar and of the bars behind it, newest first */
+static const uint8_t loadingTrail[] = {
+        MATRIX_GRAY_LEVELS - 1,
+        MATRIX_GRAY_LEVELS / 2,
+        1,
+};
+#endif
+
 /** LED matrix instance */
 static ledMatrix_t mat;
 
+/** Clip player, the only one since clips use the whole display */
+static struct {
+    const animClip_t *clip;     /**< Last clip started, NULL once stopped by a drawing */
+    animDone_t on_done;
+    bool_t playing;
+    uint8_t frame;              /**< Frame on the display */
+    uint8_t pass;               /**< Passes completed */
+    tick_t start;               /**< Time the frame was due */
+} player;
+
+/** Brightness effect, one intensity packet per level step */
+static struct {
+    bool_t active;
+    bool_t pulse;               /**< Triangle wave from 'from' to 'to' and back */
+    uint8_t from;
+    uint8_t to;
+    uint16_t ms;                /**< Ramp duration or pulse period */
+    tick_t start;
+} fader;
+
+/** Cycle completed, read by the clip wrappers */
+static bool_t cycleDone = false;
+
+/** Start of the statistics window */
+static tick_t statsStart;
+
+/*=====[Private Function Implementations]====================================*/
+
+/*
+ * Panels are side by side, text reads from the last panel of the chain to
+ * panel 0 (the chip wired to the microcontroller is on the right).
+ */
+
+/** Font image of a character, led-matrix-editor format */
+static uint64_t CharImage(char c) {
+    uint64_t image = 0x00;
+    for (uint8_t i = 0; i < 8; ++i) {
+        image |= CHAR_TO_IMAGE64x1_ROW(i, font8x8_ib8x8u[(uint8_t) c][i]);
+    }
+    return image;
+}
+
+/**
+ * Columns a character takes when scrolled, kerning included. The font has
+ * column n in bit 7 - n of every row, 'first' is the bit of the first
+ * non-blank column so the glyph is drawn without its side bearings.
+ */
+static uint8_t CharColumns(uint64_t image, uint8_t *first) {
+#if defined(ANIMATION_FIXED_FONT)
+    *first = 7;
+    return 8;
+#else
+    uint64_t used = image;      /* Every row OR'ed into the low byte */
+    used |= used >> 32;
+    used |= used >> 16;
+    used |= used >> 8;
+    used &= 0xFF;
+
+    if (used == 0) {
+        *first = 7;
+        return ANIMATION_SPACE_WIDTH;
+    }
+    *first = 31 - __builtin_clz((uint32_t) used);
+    return *first - __builtin_ctz((uint32_t) used) + 1 + ANIMATION_KERNING;
+#endif
+}
+
+/** Draws a character on one panel */
+static void DrawGlyph(uint8_t panel, char c) {
+    if ('A' <= c && c <= 'Z') {
+        MatrixSetPanelRawImage(&mat, panel, letterGlyphs[c - 'A']);
+    } else {
+        MatrixSetPanelImage(&mat, panel, CharImage(c));
+    }
+}
+
+#if defined(MATRIX_GRAY_PLANES)
+/** Loading frame in gray, the previous bars fade out behind the spinner */
+static void DrawGrayLoading(uint8_t frame) {
+    uint8_t count = sizeof(loadingFrames) / sizeof(loadingFrames[0]);
+    uint64_t planes[MATRIX_GRAY_PLANES] = { 0 };
+
+    for (int8_t age = sizeof(loadingTrail) - 1; age >= 0; age--) { /* Newer bars on top */
+        uint64_t bar = loadingFrames[(frame + count - age) % count].image;
+        for (uint8_t k = 0; k < MATRIX_GRAY_PLANES; k++) {
+            planes[k] &= ~bar;
+            if (loadingTrail[age] & (1 << k)) {
+                planes[k] |= bar;
+            }
+        }
+    }
+    MatrixGrayBlank(&mat);
+    MatrixSetGrayImage(&mat, 0, planes);
+    MatrixGrayStart(&mat);
+    MatrixUpdate(&mat);
+}
+#endif
+
+/** Shows a clip frame */
+static void DrawFrame(const animFrame_t *frame) {
+    MatrixBlank(&mat);
+    MatrixSetImage(&mat, frame->image);
+#if defined(MATRIX_GRAY_PLANES)
+    if (player.clip == &loadingClip) {
+        DrawGrayLoading(frame - loadingFrames); /* Drawing buffer shown once gray mode stops */
+        return;
+    }
+    MatrixGrayStop(&mat);
+#endif
+    MatrixUpdate(&mat);
+}
+
+/** Draws the compositor layers, replacing the whole display */
+static void DrawLayers(void) {
+    MatrixCompose(&mat);
+    MatrixUpdate(&mat);
+}
+
+/** Drawing functions other than the player take the display back */
+static void StopPlayer(void) {
+    player.clip = NULL;
+    player.playing = false;
+#if defined(MATRIX_GRAY_PLANES)
+    MatrixGrayStop(&mat);
+#endif
+}
+
+/** Moves the player to the frame due now, skipping late ones */
+static void AdvancePlayer(void) {
+    const animClip_t *clip = player.clip;
+    bool_t changed = false;
+    bool_t ended = false;
+    tick_t now = tickRead();
+
+    if (!player.playing) {
+        return;
+    }
+
+    while (now - player.start >= clip->frames[player.frame].ms) {
+        player.start += clip->frames[player.frame].ms;
+        changed = true;
+        if (++player.frame < clip->count) {
+            continue;
+        }
+        ended = true;
+        player.frame = 0;
+        if (clip->repeat != ANIM_LOOP && ++player.pass >= clip->repeat) {
+            player.frame = clip->count - 1; /* Stays on the last frame */
+            player.playing = false;
+            break;
+        }
+    }
+
+    if (changed) {
+        DrawFrame(&clip->frames[player.frame]);
+    }
+    if (ended && player.on_done != NULL) {
+        player.on_done(clip);
+    }
+}
+
+/** Sets the level due now, the driver skips levels already set */
+static void AdvanceFader(void) {
+    uint32_t elapsed = tickRead() - fader.start;
+    uint32_t span = fader.ms;
+    int32_t delta = (int32_t) fader.to - fader.from;
+    uint8_t level;
+
+    if (!fader.active) {
+        return;
+    }
+
+    if (fader.pulse) {
+        span /= 2;
+        elapsed %= fader.ms;
+        if (elapsed > span) {
+            elapsed = fader.ms - elapsed; /* Way back down */
+        }
+    } else if (elapsed >= span) {
+        elapsed = span;
+        fader.active = false;
+    }
+    level = (span > 0) ? fader.from + delta * (int32_t) elapsed / (int32_t) span : fader.to;
+    Max7219SetIntensity(&mat.dev, level);
+}
+
+/** A cycle is a pass of a looping clip or the whole finite clip */
+static void OnPassDone(const animClip_t *clip) {
+    if (clip->repeat == ANIM_LOOP || !player.playing) {
+        cycleDone = true;
+    }
+}
+
+/**
+ * Polling interface of the built-in clips. A reset only rewinds the clip,
+ * it starts on the next poll like the other animations.
+ */
+static bool_t PlayClip(const animClip_t *clip, bool_t reset) {
+    if (reset) {
+        if (player.clip == clip) {
+            StopPlayer();
+        }
+        return false;
+    }
+    if (player.clip != clip) {
+        Animation_Play(clip, OnPassDone);
+    }
+    if (cycleDone) {
+        cycleDone = false;
+        return true;
+    }
+    return false;
+}
+
 /*=====[Function Implementations]============================================*/
 
 /**
@@ -54,7 +366,125 @@ static ledMatrix_t mat;
 void Animation_Init() {
     max7219_t max7219;
     Max7219Init(&max7219, ENET_RXD1, max7219_spi_default_cfg);
-    MatrixInit(&mat, max7219, ROT_270_CW);
+    MatrixInit(&mat, max7219, MATRIX_ORIENTATION(ANIMATION_ROTATION));
+    Animation_ResetStats();
+}
+
+/**
+ * @brief Prints the frame, MAX7219 and SPI bus counters.
+ */
+void Animation_PrintStats(void) {
+    matrixStats_t m;
+    max7219Stats_t d;
+    spiBusStats_t b;
+    uint32_t ms = tickRead() - statsStart;
+    uint32_t permille;
+
+    MatrixGetStats(&mat, &m);
+    Max7219GetStats(&mat.dev, &d);
+    SpiDevGetStats(mat.dev.spi.cfg.ssp, &b);
+    if (ms == 0) {
+        ms = 1;
+    }
+    permille = b.blocked_us / ms; /* us per ms */
+
+    printf("Display: %lu ms, commits %lu (unchanged %lu, replaced %lu), sent %lu (%lu fps)\r\n",
+           (unsigned long) ms, (unsigned long) m.commits, (unsigned long) m.unchanged,
+           (unsigned long) m.replaced, (unsigned long) m.sent,
+           (unsigned long) (m.sent * 1000UL / ms));
+#if defined(MATRIX_GRAY_PLANES)
+    printf("Gray: plane cycles %lu, late plane switches %lu\r\n",
+           (unsigned long) m.gray_cycles, (unsigned long) m.gray_late);
+#endif
+    printf("MAX7219: updates %lu (idle %lu), row frames %lu, panel rows %lu\r\n",
+           (unsigned long) d.updates, (unsigned long) d.idle,
+           (unsigned long) d.frames, (unsigned long) d.rows);
+    printf("SPI: transfers %lu, bytes %lu, reconfigs %lu, blocked %lu us (%lu.%lu %% CPU)\r\n",
+           (unsigned long) b.transfers, (unsigned long) b.bytes, (unsigned long) b.reconfigs,
+           (unsigned long) b.blocked_us, (unsigned long) (permille / 10), (unsigned long) (permille % 10));
+    printf("SPI lease: longest %lu us, busy %lu\r\n",
+           (unsigned long) b.hold_us_max, (unsigned long) b.busy);
+}
+
+/**
+ * @brief Clears the frame, MAX7219 and SPI bus counters.
+ */
+void Animation_ResetStats(void) {
+    MatrixClearStats(&mat);
+    Max7219ClearStats(&mat.dev);
+    SpiDevClearStats(mat.dev.spi.cfg.ssp);
+    statsStart = tickRead();
+}
+
+/**
+ * @brief Advances the playing clip and sends the deferred frame.
+ */
+void Animation_Update(void) {
+    AdvancePlayer();
+    AdvanceFader();
+    MatrixFlush(&mat);
+}
+
+/**
+ * @brief Sets the brightness and stops the running effect.
+ */
+void Animation_SetBrightness(uint8_t level) {
+    fader.active = false;
+    Max7219SetIntensity(&mat.dev, level);
+}
+
+/**
+ * @brief Starts a brightness ramp from the current level.
+ */
+void Animation_Fade(uint8_t level, uint16_t ms) {
+    fader.active = true;
+    fader.pulse = false;
+    fader.from = Max7219GetIntensity(&mat.dev);
+    fader.to = (level > ANIM_BRIGHTNESS_MAX) ? ANIM_BRIGHTNESS_MAX : level;
+    fader.ms = ms;
+    fader.start = tickRead();
+    AdvanceFader();
+}
+
+/**
+ * @brief Starts a brightness pulse.
+ */
+void Animation_Pulse(uint8_t low, uint8_t high, uint16_t period_ms) {
+    fader.active = period_ms > 0;
+    fader.pulse = true;
+    fader.from = (low > ANIM_BRIGHTNESS_MAX) ? ANIM_BRIGHTNESS_MAX : low;
+    fader.to = (high > ANIM_BRIGHTNESS_MAX) ? ANIM_BRIGHTNESS_MAX : high;
+    fader.ms = period_ms;
+    fader.start = tickRead();
+    Max7219SetIntensity(&mat.dev, fader.from);
+}
+
+/**
+ * @brief Checks if a brightness effect is running.
+ */
+bool_t Animation_IsFading(void) {
+    return fader.active;
+}
+
+/**
+ * @brief Starts a clip from its first frame.
+ */
+void Animation_Play(const animClip_t *clip, animDone_t on_done) {
+    player.clip = clip;
+    player.on_done = on_done;
+    player.playing = true;
+    player.frame = 0;
+    player.pass = 0;
+    player.start = tickRead();
+    cycleDone = false;
+    DrawFrame(&clip->frames[0]);
+}
+
+/**
+ * @brief Checks if a clip is playing.
+ */
+bool_t Animation_IsPlaying(void) {
+    return player.playing;
 }
 
 /**
@@ -63,11 +493,23 @@ void Animation_Init() {
  * @param c Character to display.
  */
 void Animation_DrawCharacter(char c) {
-    uint64_t image = 0x00;
-    for (uint8_t i = 0; i < 8; ++i) {
-        image |= CHAR_TO_IMAGE64x1_ROW(i, font8x8_ib8x8u[c][i]);
+    StopPlayer();
+    MatrixBlank(&mat);
+    DrawGlyph(0, c);
+    MatrixUpdate(&mat);
+}
+
+/**
+ * @brief Displays a word, one character per panel.
+ *
+ * @param text The text to display, extra characters are not shown.
+ */
+void Animation_DrawText(const char *text) {
+    StopPlayer();
+    MatrixBlank(&mat);
+    for (uint8_t i = 0; i < MATRIX_PANELS && text[i] != '\0'; i++) {
+        DrawGlyph(MATRIX_PANELS - 1 - i, text[i]);
     }
-    MatrixSetImage(&mat, image);
     MatrixUpdate(&mat);
 }
 
@@ -77,17 +519,14 @@ void Animation_DrawCharacter(char c) {
  * @param number The number to display (0-99).
  */
 void Animation_DrawNumber(uint8_t number) {
-    uint8_t digit0 = number % 10;
-    uint8_t digit1 = number / 10;
-    uint64_t image = 0x00;
+    uint64_t tens = numberGlyphs[(number / 10) % 10];
+    uint64_t units = numberGlyphs[number % 10];
 
-    for (uint8_t i = 1; i < 6; ++i) {
-        image |= CHAR_TO_IMAGE64x1_ROW(i, font5x3_numbers[digit1][i]);
-        image |= CHAR_TO_IMAGE64x1_ROW(i, font5x3_numbers[digit0][i]) >> 4;
-    }
-
-    MatrixSetImage(&mat, image);
-    MatrixUpdate(&mat);
+    StopPlayer();
+    MatrixClearLayer(&mat, LAYER_TEXT);
+    MatrixBlit(&mat, LAYER_TEXT, tens, tens, PANEL0_X, 0);
+    MatrixBlit(&mat, LAYER_TEXT, units, units, PANEL0_X + DIGIT_SPACING, 0);
+    DrawLayers();
 }
 
 /**
@@ -98,57 +537,76 @@ void Animation_DrawNumber(uint8_t number) {
 void Animation_DrawRomanNumber(uint8_t number) {
     number %= 4;
     if (number != 0) {
-        uint64_t image = 0x00;
-        for (uint8_t i = 0; i < 8; ++i) {
-            image |= CHAR_TO_IMAGE64x1_ROW(i, RomanNumbers[number - 1][i]);
-        }
-        MatrixSetImage(&mat, image);
-        MatrixUpdate(&mat);
+        uint64_t glyph = romanGlyphs[number - 1];
+
+        StopPlayer();
+        MatrixClearLayer(&mat, LAYER_TEXT);
+        MatrixBlit(&mat, LAYER_TEXT, glyph, glyph, PANEL0_X, 0);
+        DrawLayers();
+    }
+}
+
+/**
+ * @brief Marks the rotor being configured on the overlay layer.
+ *
+ * @param rotor Rotor number (1-3), 0 removes the mark.
+ */
+void Animation_SetRotorIndicator(uint8_t rotor) {
+    MatrixClearLayer(&mat, LAYER_OVERLAY);
+    if (1 <= rotor && rotor <= 3) {
+        MatrixBlit(&mat, LAYER_OVERLAY, INDICATOR_SLOT(rotor), INDICATOR_MASK, PANEL0_X, 0);
     }
 }
 
 /**
  * @brief Scrolls a text message across the LED matrix.
  *
+ * Text enters on panel 0 and moves across the whole chain.
+ *
  * @param text The message to display.
  * @param reset If true, resets the scrolling animation.
  * @return true if the text has finished scrolling, false otherwise.
  */
 bool_t Animation_ShiftText(char* const text, bool_t reset) {
-    static uint8_t frame = 0;
-    static uint64_t image = 0x00;
+    static uint8_t pos = 0;         /**< Character being fed */
+    static uint8_t column = 0;      /**< Columns of it already fed */
+    static uint8_t span = 8;        /**< Columns it takes, see CharColumns() */
+    static uint8_t first = 7;       /**< Glyph bit of its first column */
+    static uint64_t glyph = 0;      /**< Its image, columns are taken from it */
+    static bool_t blank = true;     /**< Clear the display on the first frame */
     static delay_t frameDelay;
     static char* message;
-    static char current_char = 0x00;
 
     if (reset) {
-        frame = 0;
+        pos = 0;
+        column = 0;
         message = text;
-        current_char = message[0];
-        image = 0x00;
+        glyph = CharImage(message[0]);
+        span = CharColumns(glyph, &first);
+        blank = true;
         delayInit(&frameDelay, 75);
     }
 
     if (delayRead(&frameDelay)) {
-        image <<= 1;
-        image &= 0xfefefefefefefefe;
-
-        for (uint8_t i = 0; i < 8; ++i) {
-            uint8_t byte = (font8x8_ib8x8u[current_char][i] >> (7 - frame % 8)) & 0x01;
-            image |= CHAR_TO_IMAGE64x1_ROW(i, byte);
+        StopPlayer();
+        if (blank) {
+            MatrixBlank(&mat);
+            blank = false;
         }
-
-        MatrixSetImage(&mat, image);
+        /* Glyph columns first, then the blank ones */
+        MatrixScroll(&mat, (column <= first) ? glyph >> (first - column) : 0);
         MatrixUpdate(&mat);
 
-        frame++;
-        if (frame % 8 == 0) {
-            current_char = message[frame / 8];
-            if (current_char == '\0') {
-                frame = 0;
-                current_char = message[0];
-                return true;
+        if (++column == span) {
+            char next = message[++pos];
+            if (next == '\0') {
+                pos = 0;
+                next = message[0];
             }
+            column = 0;
+            glyph = CharImage(next);
+            span = CharColumns(glyph, &first);
+            return pos == 0;
         }
     }
 
@@ -162,89 +620,18 @@ bool_t Animation_ShiftText(char* const text, bool_t reset) {
  * @return true when the animation cycle completes, false otherwise.
  */
 bool_t Animation_WaitInput(bool_t reset) {
-    static uint8_t frame = 0;
-    static uint64_t image = 0x1054381000000038;
-    static delay_t frameDelay;
-
-    if (reset) {
-        frame = 0;
-        image = 0x1054381000000038;
-        delayInit(&frameDelay, 180);
-    }
-
-    if (delayRead(&frameDelay)) {
-        switch ( frame ) {
-            case 0:
-                image = 0x1054381000000038;
-                break;
-            case 1:
-                image = 0x1010543810000038;
-                break;
-            case 2:
-                image = 0x1010105438100038;
-                break;
-            case 3:
-                image = 0x0010105438100038;
-                break;
-            case 4:
-                image = 0x000010105438107c;
-                break;
-            case 5:
-                image = 0x00001010543810fe;
-                break;
-        }
-
-        MatrixSetImage(&mat, image);
-        MatrixUpdate(&mat);
-        frame = (frame + 1) % 6;
-        return frame == 5;
-    }
-
-    return false;
+    return PlayClip(&waitInputClip, reset);
 }
 
 /**
  * @brief Displays a loading animation.
  *
+ * Built with MATRIX_GRAY_PLANES the spinner leaves a fading trail, drawn
+ * with the gray planes until another drawing takes the display.
+ *
  * @param reset If true, resets the animation.
  * @return true when the animation cycle completes, false otherwise.
  */
-bool_t Animation_Loading(bool_t reset)
-{
-    static uint8_t frame = 0;
-    static uint8_t i = 2;
-    static delay_t frameDelay;
-
-    if ( reset ) {
-        frame = 0;
-        i = 2;
-        delayInit(&frameDelay, 100);
-    }
-
-    if ( delayRead(&frameDelay) )
-    {
-        switch (frame) {
-            case 0:
-                MatrixSetImage(&mat, 0x0018181818181800);
-                break;
-            case 1:
-                MatrixSetImage(&mat, 0x0002040810204000);
-                break;
-            case 2:
-                MatrixSetImage(&mat, 0x7ffe000000);
-                break;
-            case 3:
-                MatrixSetImage(&mat, 0x0040201008040200);
-                i--;
-                break;
-            default:
-                break;
-        }
-        MatrixUpdate(&mat);
-
-        frame = (frame + 1) % 4;
-        return i == 0;
-    }
-
-    return false;
+bool_t Animation_Loading(bool_t reset) {
+    return PlayClip(&loadingClip, reset);
 }
@@ -5,6 +5,9 @@
 /*==================[inclusions]=============================================*/
 
 #include "led_matrix.h"
+#if defined(MATRIX_GRAY_PLANES)
+#include "chip.h"
+#endif
 
 /*==================[typedef]================================================*/
 /**
@@ -22,6 +25,19 @@ static const delta_t move_delta[] =	{ { +1, 0 }, { -1, 0 }, { 0, +1 }, { 0, -1 }
 
 static bool tick = false;
 
+#if defined(MATRIX_GRAY_PLANES)
+#define GRAY_SLOTS (MATRIX_GRAY_LEVELS - 1)		/**< Time units of a bit plane cycle */
+#define GRAY_UNIT_US (1000000UL / (MATRIX_GRAY_HZ * GRAY_SLOTS))
+#define GRAY_NONE 0xFF
+/* Orders the gray[] stores, which are not volatile, against gray_commit.
+ * The CMSIS __DMB of LPCOpen has no memory clobber, so the compiler
+ * barrier is explicit */
+#define GRAY_BARRIER() do { __asm volatile ("" ::: "memory"); __DMB(); } while (0)
+#define GRAY_PRIORITY 7		/**< Lowest, below the PS/2 (5) and DMA (6) interrupts */
+
+static ledMatrix_t *gray_mat = NULL;	/**< Matrix in gray mode */
+#endif
+
 /*==================[internal functions definition]==========================*/
 
 static void SetTick() {
@@ -34,12 +50,12 @@ static void ResetTick() {
 
 static void TransformPoint(uint8_t x_in, uint8_t y_in, uint8_t *x_out,
 		uint8_t *y_out, matrixOrientation_t ori) {
+	/* Each panel of a chain is rotated in place */
+	uint8_t offset = (x_in > 0) ? ((x_in - 1) / MATRIX_SIZE) * MATRIX_SIZE : 0;
+	x_in -= offset;
+
 	switch (ori) {
 
-	case ROT_0_CW:
-		*x_out = x_in;
-		*y_out = y_in;
-		break;
 	case ROT_90_CW:
 		*x_out = (MATRIX_SIZE + 1) - y_in;
 		*y_out = x_in;
@@ -52,9 +68,194 @@ static void TransformPoint(uint8_t x_in, uint8_t y_in, uint8_t *x_out,
 		*x_out = y_in;
 		*y_out = (MATRIX_SIZE + 1) - x_in;
 		break;
+	case ROT_0_CW:
+	default:
+		*x_out = x_in;
+		*y_out = y_in;
+		break;
+	}
+	*x_out += offset;
+}
+
+/*
+ * Word level image kernels. A uint64_t holds the 8x8 image with row r in
+ * byte r and column c in bit c of that byte (led-matrix-editor format).
+ */
+
+/* Reverses the bit order inside every byte (mirror left-right) */
+static uint64_t MirrorRows(uint64_t x) {
+	x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+	x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+	x = ((x >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((x & 0x0F0F0F0F0F0F0F0FULL) << 4);
+	return x;
+}
+
+/* Reverses the byte order (flip top-bottom), a single REV pair on Cortex-M */
+static uint64_t FlipRows(uint64_t x) {
+	return __builtin_bswap64(x);
+}
+
+/* Swaps rows and columns: bit c of row r goes to bit r of row c */
+static uint64_t Transpose(uint64_t x) {
+	uint64_t t;
+	t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+	x ^= t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+	x ^= t ^ (t << 14);
+	t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+	x ^= t ^ (t << 28);
+	return x;
+}
+
+/*
+ * Converts an image to the MAX7219 buffer layout for an orientation, same
+ * mapping as TransformPoint(). The buffer keeps y - 1 in the byte index and
+ * x = 1 in bit 7, so 0 degrees is already a mirror.
+ */
+static uint64_t OrientImage(uint64_t img, matrixOrientation_t ori) {
+	switch (ori) {
+	case ROT_90_CW:
+		return Transpose(img);
+	case ROT_180_CW:
+		return FlipRows(img);
+	case ROT_270_CW:
+		return FlipRows(MirrorRows(Transpose(img)));
+	case ROT_0_CW:
+	default:
+		return MirrorRows(img);
+	}
+}
+
+/* Inverse of OrientImage(), buffer layout back to an image */
+static uint64_t UnorientImage(uint64_t raw, matrixOrientation_t ori) {
+	switch (ori) {
+	case ROT_90_CW:
+		return Transpose(raw);
+	case ROT_180_CW:
+		return FlipRows(raw);
+	case ROT_270_CW:
+		return Transpose(MirrorRows(FlipRows(raw)));
+	case ROT_0_CW:
+	default:
+		return MirrorRows(raw);
+	}
+}
+
+/* Moves an image s columns right (towards bit 0) or left, 0 <= s < 8.
+ * Columns leaving a row are dropped instead of entering the next row */
+static uint64_t ShiftRight(uint64_t x, uint8_t s) {
+	return (x >> s) & (0x0101010101010101ULL * (uint8_t) (0xFF >> s));
+}
+
+static uint64_t ShiftLeft(uint64_t x, uint8_t s) {
+	return (x << s) & (0x0101010101010101ULL * (uint8_t) (0xFF << s));
+}
+
+/* Moves an image y rows down, or up if negative. The top row is the high byte */
+static uint64_t ShiftDown(uint64_t x, int8_t y) {
+	if (y <= -MATRIX_SIZE || y >= MATRIX_SIZE) {
+		return 0;
+	}
+	return (y >= 0) ? x >> (y * 8) : x << (-y * 8);
+}
+
+/* Draws a sprite already shifted into the panel 'col' panels from the left */
+static void BlitPanel(matrixLayerData_t *layer, int16_t col, uint64_t sprite,
+		uint64_t mask) {
+	uint8_t panel;
+
+	if (col < 0 || col >= MATRIX_PANELS || mask == 0) {
+		return;
+	}
+	panel = MATRIX_PANELS - 1 - col;
+	layer->img[panel] = (layer->img[panel] & ~mask) | (sprite & mask);
+	layer->mask[panel] |= mask;
+}
+
+static uint64_t LoadBuffer(ledMatrix_t *mat, uint8_t panel) {
+	uint64_t word = 0;
+	for (uint8_t row = 0; row < MATRIX_SIZE; row++) {
+		word |= (uint64_t) mat->back[panel][row] << (row * MATRIX_SIZE);
+	}
+	return word;
+}
+
+static void StoreBuffer(ledMatrix_t *mat, uint8_t panel, uint64_t word) {
+	for (uint8_t row = 0; row < MATRIX_SIZE; row++) {
+		mat->back[panel][row] = (uint8_t) (word >> (row * MATRIX_SIZE));
+	}
+}
+
+/*
+ * Back buffer byte of a point, same layout as the MAX7219 data buffer.
+ * (x, y) already transformed. Returns null if out of range
+ */
+static uint8_t *BackPoint(ledMatrix_t *mat, uint8_t x, uint8_t y, uint8_t *mask) {
+	if (x == 0 || x > MATRIX_WIDTH || y == 0 || y > MATRIX_SIZE) {
+		return null;
+	}
+	*mask = 1 << (MATRIX_SIZE - 1 - (x - 1) % MATRIX_SIZE);
+	return &mat->back[(x - 1) / MATRIX_SIZE][y - 1];
+}
+
+#if defined(MATRIX_GRAY_PLANES)
+/*
+ * One time unit of the bit plane cycle. Plane k is due from unit 2^k - 1,
+ * it is sent when due if the bus is free, else retried on the next unit.
+ * Max7219Update only sends the rows that differ from the previous plane.
+ */
+static void GrayTick(ledMatrix_t *mat) {
+	uint8_t plane;
+
+	if (++mat->gray_slot >= GRAY_SLOTS) {
+		mat->gray_slot = 0;
+		mat->stats.gray_cycles++;
+		if (mat->gray_commit) {
+			for (uint8_t k = 0; k < MATRIX_GRAY_PLANES; k++) {
+				for (uint8_t panel = 0; panel < MATRIX_PANELS; panel++) {
+					mat->gray_front[k][panel] = mat->gray[k][panel];
+				}
+			}
+			mat->gray_commit = false;
+			mat->gray_shown = GRAY_NONE;
+		}
+	}
+	plane = 31 - __builtin_clz(mat->gray_slot + 1);
+	if (plane == mat->gray_shown) {
+		return;
+	}
+	if (!SpiDevTryLock(&mat->dev.spi)) {
+		mat->stats.gray_late++;
+		return;
+	}
+	for (uint8_t panel = 0; panel < MATRIX_PANELS; panel++) {
+		uint64_t word = mat->gray_front[plane][panel];
+		for (uint8_t row = 0; row < MATRIX_SIZE; row++) {
+			mat->dev.data[panel][row] = (uint8_t) (word >> (row * MATRIX_SIZE));
+		}
+	}
+	Max7219Update(&(mat->dev));
+	SpiDevUnlock(&mat->dev.spi);
+	mat->gray_shown = plane;
+}
+
+void TIMER1_IRQHandler(void) {
+	if (Chip_TIMER_MatchPending(LPC_TIMER1, 0)) {
+		Chip_TIMER_ClearMatch(LPC_TIMER1, 0);
+		if (gray_mat != NULL) {
+			GrayTick(gray_mat);
+		}
 	}
 }
 
+/* Called before the drawing planes change, a commit not taken yet is
+ * dropped so the ISR never copies a half drawn frame */
+static void GrayDraw(ledMatrix_t *mat) {
+	mat->gray_commit = false;
+	GRAY_BARRIER();
+}
+#endif
+
 /*==================[external functions definition]==========================*/
 
 void MatrixInit(ledMatrix_t *mat, max7219_t dev, matrixOrientation_t ori) {
@@ -64,71 +265,211 @@ void MatrixInit(ledMatrix_t *mat, max7219_t dev, matrixOrientation_t ori) {
 	mat->st_pt.y = 1;
 	mat->st_pt.status = RST_POINT;
 	mat->st_pt.staged = false;
+	for (uint8_t panel = 0; panel < MATRIX_PANELS; panel++) {
+		Max7219GetImage(&(mat->dev), panel, mat->back[panel]);
+	}
+	mat->pending = false;
+	MatrixClearStats(mat);
+	for (uint8_t l = 0; l < MATRIX_LAYERS; l++) {
+		MatrixClearLayer(mat, l);
+	}
+#if defined(MATRIX_GRAY_PLANES)
+	mat->gray_on = false;
+	mat->gray_commit = false;
+	for (uint8_t k = 0; k < MATRIX_GRAY_PLANES; k++) {
+		for (uint8_t panel = 0; panel < MATRIX_PANELS; panel++) {
+			mat->gray[k][panel] = 0;
+		}
+	}
+#endif
+	MatrixSetFrameRate(mat, MATRIX_FPS);
+	mat->last_sent = tickRead() - mat->frame_ms; /* First commit is not deferred */
 }
 
 void MatrixUpdate(ledMatrix_t *mat) {
-	Max7219Update(&(mat->dev));
-}
+	bool changed = false;
+
+#if defined(MATRIX_GRAY_PLANES)
+	if (mat->gray_on) {
+		mat->stats.commits++;
+		GRAY_BARRIER(); /* Planes complete before they are taken */
+		mat->gray_commit = true;
+		return;
+	}
+#endif
 
-void MatrixBlank(ledMatrix_t *mat) {
-	Max7219Blank(&(mat->dev));
+	for (uint8_t panel = 0; panel < MATRIX_PANELS; panel++) {
+		for (uint8_t row = 0; row < MATRIX_SIZE; row++) {
+			changed |= mat->back[panel][row] != mat->dev.data[panel][row];
+		}
+		Max7219SetImage(&(mat->dev), panel, mat->back[panel]);
+	}
+	mat->stats.commits++;
+	if (!changed) {
+		mat->stats.unchanged++;
+	}
+	if (mat->pending) {
+		mat->stats.replaced++; /* Deferred frame never sent */
+	}
+	mat->pending = true;
+	MatrixFlush(mat);
 }
 
-void MatrixRotate(ledMatrix_t *mat, matrixOrientation_t ori) {
-	ledStatus_t status;
-	uint8_t x_tf;
-	uint8_t y_tf;
+void MatrixFlush(ledMatrix_t *mat) {
+	tick_t now = tickRead();
 
-	max7219_t virtual_dev;
-	max7219Data_t dat;
-	Max7219GetImage(&(mat->dev), dat);
-	Max7219Blank(&(mat->dev));
-	Max7219SetImage(&virtual_dev, dat);
+#if defined(MATRIX_GRAY_PLANES)
+	if (mat->gray_on) {
+		return; /* The chips show the bit planes */
+	}
+#endif
+	if (mat->pending && now - mat->last_sent >= mat->frame_ms) {
+		Max7219Update(&(mat->dev)); /* Only the rows that changed */
+		mat->last_sent = now;
+		mat->pending = false;
+		mat->stats.sent++;
+	}
+}
 
-	for (uint8_t row = 0; row < MATRIX_SIZE; row++) {
-		for (uint8_t col = 0; col < MATRIX_SIZE; col++) {
+#if defined(MATRIX_GRAY_PLANES)
+void MatrixGrayStart(ledMatrix_t *mat) {
+	if (mat->gray_on) {
+		return;
+	}
+	mat->gray_slot = GRAY_SLOTS - 1;	/* First unit starts a cycle */
+	mat->gray_shown = GRAY_NONE;
+	GRAY_BARRIER();
+	mat->gray_commit = true;
+	mat->gray_on = true;
+	gray_mat = mat;
+
+	Chip_TIMER_Init(LPC_TIMER1);
+	Chip_TIMER_Reset(LPC_TIMER1);
+	Chip_TIMER_MatchEnableInt(LPC_TIMER1, 0);
+	Chip_TIMER_SetMatch(LPC_TIMER1, 0,
+			(Chip_Clock_GetRate(CLK_MX_TIMER1) / 1000000) * GRAY_UNIT_US);
+	Chip_TIMER_ResetOnMatchEnable(LPC_TIMER1, 0);
+	Chip_TIMER_Enable(LPC_TIMER1);
+
+	NVIC_SetPriority(TIMER1_IRQn, GRAY_PRIORITY);
+	NVIC_ClearPendingIRQ(TIMER1_IRQn);
+	NVIC_EnableIRQ(TIMER1_IRQn);
+}
 
-			status = Max7219GetPoint(&(virtual_dev), col + 1, row + 1);
+void MatrixGrayStop(ledMatrix_t *mat) {
+	if (!mat->gray_on) {
+		return;
+	}
+	NVIC_DisableIRQ(TIMER1_IRQn);
+	Chip_TIMER_Disable(LPC_TIMER1);
+	Chip_TIMER_DeInit(LPC_TIMER1);
+	gray_mat = NULL;
+	mat->gray_on = false;
+
+	/* Drawing buffer back on the chips */
+	for (uint8_t panel = 0; panel < MATRIX_PANELS; panel++) {
+		Max7219SetImage(&(mat->dev), panel, mat->back[panel]);
+	}
+	mat->pending = true;
+	mat->last_sent = tickRead() - mat->frame_ms;
+	MatrixFlush(mat);
+}
 
-			if (status == SET_POINT) {
-				TransformPoint(col + 1, row + 1, &x_tf, &y_tf, ori);
-				Max7219SetPoint(&(mat->dev), x_tf, y_tf);
-			}
+void MatrixGrayBlank(ledMatrix_t *mat) {
+	GrayDraw(mat);
+	for (uint8_t k = 0; k < MATRIX_GRAY_PLANES; k++) {
+		for (uint8_t panel = 0; panel < MATRIX_PANELS; panel++) {
+			mat->gray[k][panel] = 0;
+		}
+	}
+}
 
+void MatrixSetGrayImage(ledMatrix_t *mat, uint8_t panel,
+		const uint64_t planes[MATRIX_GRAY_PLANES]) {
+	if (panel < MATRIX_PANELS) {
+		GrayDraw(mat);
+		for (uint8_t k = 0; k < MATRIX_GRAY_PLANES; k++) {
+			mat->gray[k][panel] = OrientImage(planes[k], mat->ori);
 		}
 	}
 }
+#endif
+
+void MatrixGetStats(ledMatrix_t *mat, matrixStats_t *stats) {
+	*stats = mat->stats;
+}
+
+void MatrixClearStats(ledMatrix_t *mat) {
+	mat->stats = (matrixStats_t) { 0 };
+}
+
+void MatrixSetFrameRate(ledMatrix_t *mat, uint16_t fps) {
+	mat->frame_ms = (fps > 0) ? (1000 + fps - 1) / fps : 0;
+}
+
+void MatrixBlank(ledMatrix_t *mat) {
+	for (uint8_t panel = 0; panel < MATRIX_PANELS; panel++) {
+		StoreBuffer(mat, panel, 0);
+	}
+}
+
+void MatrixRotate(ledMatrix_t *mat, matrixOrientation_t ori) {
+	for (uint8_t panel = 0; panel < MATRIX_PANELS; panel++) {
+		/* Buffer back to image layout, then the same kernel as MatrixSetImage */
+		uint64_t img = MirrorRows(LoadBuffer(mat, panel));
+		StoreBuffer(mat, panel, OrientImage(img, ori));
+	}
+}
 
 void MatrixSetPoint(ledMatrix_t *mat, uint8_t x, uint8_t y) {
 	uint8_t x_tf;
 	uint8_t y_tf;
+	uint8_t mask;
+	uint8_t *row;
 	TransformPoint(x, y, &x_tf, &y_tf, mat->ori);
-	Max7219SetPoint(&(mat->dev), x_tf, y_tf);
+	row = BackPoint(mat, x_tf, y_tf, &mask);
+	if (row != null) {
+		*row |= mask;
+	}
 }
 
 void MatrixRstPoint(ledMatrix_t *mat, uint8_t x, uint8_t y) {
 	uint8_t x_tf;
 	uint8_t y_tf;
+	uint8_t mask;
+	uint8_t *row;
 	TransformPoint(x, y, &x_tf, &y_tf, mat->ori);
-	Max7219ResetPoint(&(mat->dev), x_tf, y_tf);
+	row = BackPoint(mat, x_tf, y_tf, &mask);
+	if (row != null) {
+		*row &= ~mask;
+	}
 }
 
 ledStatus_t MatrixTogPoint(ledMatrix_t *mat, uint8_t x, uint8_t y) {
-	ledStatus_t status;
 	uint8_t x_tf;
 	uint8_t y_tf;
+	uint8_t mask;
+	uint8_t *row;
 	TransformPoint(x, y, &x_tf, &y_tf, mat->ori);
-	status = Max7219TogglePoint(&(mat->dev), x_tf, y_tf);
-	return status;
+	row = BackPoint(mat, x_tf, y_tf, &mask);
+	if (row == null) {
+		return INVALID;
+	}
+	*row ^= mask;
+	return (*row & mask) ? SET_POINT : RST_POINT;
 }
 
 ledStatus_t MatrixGetPoint(ledMatrix_t *mat, uint8_t x, uint8_t y) {
-	ledStatus_t status;
 	uint8_t x_tf;
 	uint8_t y_tf;
+	uint8_t mask;
+	uint8_t *row;
 	TransformPoint(x, y, &x_tf, &y_tf, mat->ori);
-	status = Max7219GetPoint(&(mat->dev), x_tf, y_tf);
-	return status;
+	row = BackPoint(mat, x_tf, y_tf, &mask);
+	if (row == null) {
+		return INVALID;
+	}
+	return (*row & mask) ? SET_POINT : RST_POINT;
 }
 
 /**
@@ -138,30 +479,105 @@ ledStatus_t MatrixGetPoint(ledMatrix_t *mat, uint8_t x, uint8_t y) {
  *
  */
 void MatrixSetImage(ledMatrix_t *mat, uint64_t img) {
+	MatrixSetPanelImage(mat, 0, img);
+}
 
-	for (uint8_t row = 0; row < MATRIX_SIZE; row++) {
-
-		uint8_t img_row = (img >> row * MATRIX_SIZE) & 0xFF;
+void MatrixSetRawImage(ledMatrix_t *mat, uint64_t raw) {
+	MatrixSetPanelRawImage(mat, 0, raw);
+}
 
-		for (uint8_t col = 0; col < MATRIX_SIZE; col++) {
+void MatrixSetPanelImage(ledMatrix_t *mat, uint8_t panel, uint64_t img) {
+	if (panel < MATRIX_PANELS) {
+		StoreBuffer(mat, panel, OrientImage(img, mat->ori));
+	}
+}
 
-			uint8_t value = (img_row >> col) & (0x01);
+void MatrixSetPanelRawImage(ledMatrix_t *mat, uint8_t panel, uint64_t raw) {
+	if (panel < MATRIX_PANELS) {
+		StoreBuffer(mat, panel, raw);
+	}
+}
 
-			if (value == 1) {
-				MatrixSetPoint(mat, col + 1, row + 1);
-			} else {
-				MatrixRstPoint(mat, col + 1, row + 1);
-			}
+/*
+ * The shift runs on the buffer layout, so the direction depends on the
+ * orientation (see OrientImage): a column is a bit of every byte at 0 and
+ * 180 degrees and a whole byte at 90 and 270 degrees.
+ */
+void MatrixScroll(ledMatrix_t *mat, uint64_t column) {
+	uint64_t in = OrientImage(column & 0x0101010101010101ULL, mat->ori);
+
+	for (uint8_t panel = 0; panel < MATRIX_PANELS; panel++) {
+		uint64_t raw = LoadBuffer(mat, panel);
+		uint64_t out;
+
+		switch (mat->ori) {
+		case ROT_90_CW:
+			out = raw >> 56;
+			raw = (raw << 8) | in;
+			break;
+		case ROT_180_CW:
+			out = (raw & 0x8080808080808080ULL) >> 7;
+			raw = ((raw << 1) & 0xFEFEFEFEFEFEFEFEULL) | in;
+			break;
+		case ROT_270_CW:
+			out = raw << 56;
+			raw = (raw >> 8) | in;
+			break;
+		case ROT_0_CW:
+		default:
+			out = (raw & 0x0101010101010101ULL) << 7;
+			raw = ((raw >> 1) & 0x7F7F7F7F7F7F7F7FULL) | in;
+			break;
 		}
+		StoreBuffer(mat, panel, raw);
+		in = out; /* Enters the next panel where it entered this one */
+	}
+}
+
+void MatrixGetImage(ledMatrix_t *mat, uint64_t *img) {
+	MatrixGetPanelImage(mat, 0, img);
+}
+
+void MatrixGetPanelImage(ledMatrix_t *mat, uint8_t panel, uint64_t *img) {
+	*img = (panel < MATRIX_PANELS) ?
+			UnorientImage(LoadBuffer(mat, panel), mat->ori) : 0;
+}
+
+void MatrixClearLayer(ledMatrix_t *mat, matrixLayer_t layer) {
+	for (uint8_t panel = 0; panel < MATRIX_PANELS; panel++) {
+		mat->layers[layer].img[panel] = 0;
+		mat->layers[layer].mask[panel] = 0;
 	}
 }
 
-void MatrixGetImage(ledMatrix_t *mat, uint64_t *img){
-	//TODO
+void MatrixBlit(ledMatrix_t *mat, matrixLayer_t layer, uint64_t sprite,
+		uint64_t mask, int16_t x, int8_t y) {
+	/* Floor division, the sprite spans panel 'col' and maybe the next one */
+	int16_t col = (x >= 0) ? x / MATRIX_SIZE : -((MATRIX_SIZE - 1 - x) / MATRIX_SIZE);
+	uint8_t s = x - col * MATRIX_SIZE;
+
+	sprite = ShiftDown(sprite, y);
+	mask = ShiftDown(mask, y);
+	BlitPanel(&mat->layers[layer], col, ShiftRight(sprite, s), ShiftRight(mask, s));
+	if (s > 0) {
+		BlitPanel(&mat->layers[layer], col + 1, ShiftLeft(sprite, MATRIX_SIZE - s),
+				ShiftLeft(mask, MATRIX_SIZE - s));
+	}
+}
+
+void MatrixCompose(ledMatrix_t *mat) {
+	for (uint8_t panel = 0; panel < MATRIX_PANELS; panel++) {
+		uint64_t img = 0;
+
+		for (uint8_t l = 0; l < MATRIX_LAYERS; l++) {
+			img = (img & ~mat->layers[l].mask[panel]) | mat->layers[l].img[panel];
+		}
+		StoreBuffer(mat, panel, OrientImage(img, mat->ori));
+	}
 }
 
 void MatrixStagePoint(ledMatrix_t *mat, uint8_t x, uint8_t y) {
-	if (x > 0 && x < 9 && y > 0 && y < 9) {
+	if (x > 0 && x <= MATRIX_WIDTH && y > 0 && y <= MATRIX_SIZE) {
 		mat->st_pt.x = x;
 		mat->st_pt.y = y;
 		mat->st_pt.status = MatrixGetPoint(mat, x, y);
@@ -197,8 +613,8 @@ void MatrixMoveStagedPoint(ledMatrix_t *mat, moveDir_t dir) {
 
 	/* Toroidal movement */
 	if (x == 0)
-		x = 8;
-	if (x == 9)
+		x = MATRIX_WIDTH;
+	if (x == MATRIX_WIDTH + 1)
 		x = 1;
 	if (y == 0)
 		y = 8;
@@ -20,13 +20,65 @@ spiConfig_t max7219_spi_default_cfg = { SSP_1, SPI_BITS16, SPI_CLK_MODE0,
 static const uint16_t default_init_seq[] = {
 	PACKET(SHUTDOWN, NORMAL_OPERATION),
 	PACKET(SCAN_LIMIT, EIGHT),
-	PACKET(INTENSITY, SET_INTENSITY(5)),
+	PACKET(INTENSITY, SET_INTENSITY(DEFAULT_INTENSITY)),
 	PACKET(DECODE_MODE, NO_DECODE),
 	PACKET(DISPLAY_TEST, DISPLAY_TEST_OFF)
 };
 
 /*==================[internal functions definition]==========================*/
 
+#if defined(MAX7219_TRACE)
+/* Registers and traffic seen on the bus */
+static struct {
+	uint8_t digit[MAX7219_PANELS][MAX7219_SIZE]; /**< Decoded digit registers */
+	uint32_t updates;		/**< Max7219Update calls that sent something */
+	uint32_t packets;		/**< Digit packets */
+	uint32_t no_ops;		/**< No-op packets padding digit frames (row unchanged on that panel) */
+	uint32_t digit_bytes;	/**< Bytes of the frames carrying digit packets, no-ops included */
+	uint32_t control_bytes;	/**< Bytes of the other frames: init, intensity */
+	tick_t first;			/**< Time of the first update */
+	tick_t last;			/**< Time of the last update */
+} trace;
+
+/* Decodes a chip select frame, the first packet ends in the last panel */
+static void TraceFrame(const uint16_t *packets, uint32_t n_packets) {
+	uint32_t digits = 0;
+	uint32_t no_ops = 0;
+
+	for (uint32_t p = 0; p < n_packets && p < MAX7219_PANELS; p++) {
+		uint8_t cmd = packets[p] >> 8;
+		uint8_t data = packets[p] & 0xFF;
+		uint8_t panel = MAX7219_PANELS - 1 - p;
+
+		if (cmd >= DIGIT_0 && cmd <= DIGIT_7) {
+			digits++;
+			trace.digit[panel][cmd - DIGIT_0] = data;
+		} else if (cmd == NO_OP) {
+			no_ops++;
+		}
+	}
+	if (digits > 0) {
+		trace.packets += digits;
+		trace.no_ops += no_ops;
+		trace.digit_bytes += n_packets * sizeof(uint16_t);
+	} else {
+		trace.control_bytes += n_packets * sizeof(uint16_t);
+	}
+}
+
+static void TraceUpdate(void) {
+	trace.last = tickRead();
+	if (trace.updates++ == 0) {
+		trace.first = trace.last;
+	}
+}
+
+static bool TraceLed(uint8_t x, uint8_t y) {
+	return (trace.digit[(x - 1) / MAX7219_SIZE][y - 1]
+			>> (MAX7219_SIZE - 1 - (x - 1) % MAX7219_SIZE)) & 0x01;
+}
+#endif
+
 static void CsLow(max7219_t *max7219) {
 //	GpioWrite(&max7219->cs, GPIO_LOW);
 	gpioWrite(max7219->cs, 0);
@@ -37,25 +89,88 @@ static void CsHigh(max7219_t *max7219) {
 	gpioWrite(max7219->cs, 1);
 }
 
+static void Select(void *ctx, bool active) {
+	if (active) {
+		CsLow((max7219_t *) ctx);
+	} else {
+		CsHigh((max7219_t *) ctx);
+	}
+}
+
+/*
+ * Queues packets as one chip select frame, the first one ends in the last
+ * panel. Sent on SpiDevFlush(), the packets must be kept until then
+ */
+static void SpiQueueFrame(max7219_t *max7219, const uint16_t *packets, uint32_t n_packets) {
+#if defined(MAX7219_TRACE)
+	TraceFrame(packets, n_packets);
+#endif
+	SpiDevQueueWrite(&max7219->spi, packets, n_packets * sizeof(uint16_t), Select, max7219);
+}
+
+#if defined(MAX7219_USE_DMA)
+static void DmaFrameStart(void *ctx) {
+	CsLow((max7219_t *) ctx);
+}
+
+static void DmaFrameDone(void *ctx) {
+	CsHigh((max7219_t *) ctx);
+}
+
+/* Queues the frame of a row, sent while the next rows are prepared */
+static void SpiWriteRowAsync(max7219_t *max7219, uint8_t row) {
+	spiTransfer_t *xfer = &max7219->xfer[row];
+
+	xfer->tx = max7219->frames[row];
+	xfer->bytes = sizeof(max7219->frames[row]);
+	xfer->on_start = DmaFrameStart;
+	xfer->on_done = DmaFrameDone;
+	xfer->ctx = max7219;
+#if defined(MAX7219_TRACE)
+	TraceFrame(max7219->frames[row], MAX7219_PANELS);
+#endif
+	while (!SpiDevWriteAsync(&max7219->spi, xfer)) {
+		SpiDevWait(&max7219->spi); /* Queue full with other devices transfers */
+	}
+}
+#endif
+
+/* Sends each command to every panel of the chain */
 static void SpiWrite(max7219_t *max7219, const uint16_t *buffer, uint32_t n_commands) {
-	uint32_t cnt = 0;
-	void * ptr;
-	while (cnt < n_commands) {
-		ptr = ((void *) ((uint32_t) buffer + cnt));
-		CsLow(max7219);
-		SpiDevWriteBlocking(&max7219->spi, ptr, sizeof(uint16_t));
-		CsHigh(max7219);
-		cnt++;
+	uint16_t frames[SPI_BATCH_SIZE][MAX7219_PANELS];
+	uint8_t queued = 0;
+
+	for (uint32_t cnt = 0; cnt < n_commands; cnt++) {
+		if (queued == SPI_BATCH_SIZE) {
+			SpiDevFlush(max7219->spi.cfg.ssp); /* Frames are reused */
+			queued = 0;
+		}
+		for (uint8_t p = 0; p < MAX7219_PANELS; p++) {
+			frames[queued][p] = buffer[cnt];
+		}
+		SpiQueueFrame(max7219, frames[queued], MAX7219_PANELS);
+		queued++;
 	}
+	SpiDevFlush(max7219->spi.cfg.ssp);
 }
 
 static bool ValidPoint(uint8_t x, uint8_t y) {
-	if (x > 0 && x < 9 && y > 0 && y < 9)
+	if (x > 0 && x <= MAX7219_WIDTH && y > 0 && y <= MAX7219_SIZE)
 		return true;
 	else
 		return false;
 }
 
+/* Buffer byte holding point (x, y), x and y already validated */
+static uint8_t *PointRow(max7219_t *max7219, uint8_t x, uint8_t y) {
+	return &max7219->data[(x - 1) / MAX7219_SIZE][y - 1];
+}
+
+/* Bit of point x inside its row byte, column 1 of a panel is bit 7 */
+static uint8_t PointMask(uint8_t x) {
+	return 1 << (MAX7219_SIZE - 1 - (x - 1) % MAX7219_SIZE);
+}
+
 /*==================[external functions definition]==========================*/
 
 void Max7219Init(max7219_t *max7219, gpioMap_t cs_pin, spiConfig_t cfg) {
@@ -67,20 +182,100 @@ void Max7219Init(max7219_t *max7219, gpioMap_t cs_pin, spiConfig_t cfg) {
 	gpioConfig(max7219->cs, 1); // IS ACTIVE LOW
 
 	SpiWrite(max7219, default_init_seq, 5); // 5 Initialization commands
+	max7219->intensity = DEFAULT_INTENSITY;
 	Max7219Blank(max7219);
+	Max7219Invalidate(max7219);
 	Max7219Update(max7219);
+#if defined(MAX7219_USE_DMA)
+	SpiDevWait(&max7219->spi); /* The structure may be copied once initialized */
+#endif
+	Max7219ClearStats(max7219);
 }
 
 void Max7219Update(max7219_t *max7219) {
+	bool sent_any = false;
+#if defined(MAX7219_USE_DMA)
+	SpiDevWait(&max7219->spi); /* Previous frames still being read */
+#endif
+
 	for (uint8_t i = DIGIT_0; i <= DIGIT_7; i++) {
-		uint16_t packet = SpiDevMake2BPacket(i, max7219->data[i - 1]);
-		SpiWrite(max7219, &packet, 1);
+		bool changed = false;
+		uint16_t *frame = max7219->frames[i - 1];
+
+		/* Last panel first, it is the farthest one down the chain */
+		for (uint8_t p = 0; p < MAX7219_PANELS; p++) {
+			uint8_t panel = MAX7219_PANELS - 1 - p;
+			uint8_t row = max7219->data[panel][i - 1];
+
+			if (max7219->synced && max7219->sent[panel][i - 1] == row) {
+				frame[p] = SpiDevMake2BPacket(NO_OP, 0); /* Row unchanged */
+			} else {
+				frame[p] = SpiDevMake2BPacket(i, row);
+				max7219->sent[panel][i - 1] = row;
+				max7219->stats.rows++;
+				changed = true;
+			}
+		}
+		if (changed) {
+			sent_any = true;
+			max7219->stats.frames++;
+#if defined(MAX7219_USE_DMA)
+			SpiWriteRowAsync(max7219, i - 1);
+#else
+			SpiQueueFrame(max7219, frame, MAX7219_PANELS);
+#endif
+		}
+	}
+#if !defined(MAX7219_USE_DMA)
+	SpiDevFlush(max7219->spi.cfg.ssp); /* Changed rows in one batch */
+#endif
+	max7219->synced = true;
+	max7219->stats.updates++;
+	if (!sent_any) {
+		max7219->stats.idle++;
+	}
+#if defined(MAX7219_TRACE)
+	else {
+		TraceUpdate();
 	}
+#endif
+}
+
+void Max7219GetStats(max7219_t *max7219, max7219Stats_t *stats) {
+	*stats = max7219->stats;
+}
+
+void Max7219ClearStats(max7219_t *max7219) {
+	max7219->stats = (max7219Stats_t) { 0 };
+}
+
+void Max7219Invalidate(max7219_t *max7219) {
+	max7219->synced = false;
+}
+
+void Max7219SetIntensity(max7219_t *max7219, uint8_t level) {
+	uint16_t packet;
+
+	if (level > MAX_INTENSITY) {
+		level = MAX_INTENSITY;
+	}
+	if (level == max7219->intensity) {
+		return;
+	}
+	packet = SpiDevMake2BPacket(INTENSITY, SET_INTENSITY(level));
+	SpiWrite(max7219, &packet, 1);
+	max7219->intensity = level;
+}
+
+uint8_t Max7219GetIntensity(max7219_t *max7219) {
+	return max7219->intensity;
 }
 
 void Max7219Blank(max7219_t *max7219) {
-	for (uint8_t i = 0; i < MAX7219_SIZE; i++) {
-		max7219->data[i] = 0x00;
+	for (uint8_t p = 0; p < MAX7219_PANELS; p++) {
+		for (uint8_t i = 0; i < MAX7219_SIZE; i++) {
+			max7219->data[p][i] = 0x00;
+		}
 	}
 }
 
@@ -88,7 +283,7 @@ ledStatus_t Max7219SetPoint(max7219_t *max7219, uint8_t x, uint8_t y) {
 	if (!ValidPoint(x, y)) {
 		return INVALID;
 	}
-	max7219->data[y - 1] |= 1 << (MAX7219_SIZE - x);
+	*PointRow(max7219, x, y) |= PointMask(x);
 	return SET_POINT;
 }
 
@@ -96,7 +291,7 @@ ledStatus_t Max7219ResetPoint(max7219_t *max7219, uint8_t x, uint8_t y) {
 	if (!ValidPoint(x, y)) {
 		return INVALID;
 	}
-	max7219->data[y - 1] &= ~(1 << (MAX7219_SIZE - x));
+	*PointRow(max7219, x, y) &= ~PointMask(x);
 	return RST_POINT;
 }
 
@@ -118,21 +313,71 @@ ledStatus_t Max7219GetPoint(max7219_t *max7219, uint8_t x, uint8_t y) {
 	if (!ValidPoint(x, y)) {
 		return INVALID;
 	}
-	uint8_t row = max7219->data[y - 1];
-	ledStatus_t status = (row >> (MAX7219_SIZE - x)) & (0x01);
+	ledStatus_t status = (*PointRow(max7219, x, y) & PointMask(x)) ? SET_POINT : RST_POINT;
 	return status;
 }
 
-void Max7219SetImage(max7219_t *max7219, max7219Data_t src_img) {
+void Max7219SetImage(max7219_t *max7219, uint8_t panel, max7219Data_t src_img) {
+	if (panel >= MAX7219_PANELS) {
+		return;
+	}
 	for (uint8_t i = 0; i < MAX7219_SIZE; i++) {
-		max7219->data[i] = src_img[i];
+		max7219->data[panel][i] = src_img[i];
 	}
 }
 
-void Max7219GetImage(max7219_t *max7219, max7219Data_t tar_img) {
+void Max7219GetImage(max7219_t *max7219, uint8_t panel, max7219Data_t tar_img) {
+	if (panel >= MAX7219_PANELS) {
+		return;
+	}
 	for (uint8_t i = 0; i < MAX7219_SIZE; i++) {
-		tar_img[i] = max7219->data[i];
+		tar_img[i] = max7219->data[panel][i];
+	}
+}
+
+#if defined(MAX7219_TRACE)
+void Max7219TraceReset(void) {
+	trace.updates = 0;
+	trace.packets = 0;
+	trace.no_ops = 0;
+	trace.digit_bytes = 0;
+	trace.control_bytes = 0;
+}
+
+void Max7219TraceReport(void) {
+	uint32_t span = (uint32_t) (trace.last - trace.first);
+	uint32_t updates = (trace.updates > 0) ? trace.updates : 1;
+	uint32_t slots = (trace.packets + trace.no_ops > 0) ? trace.packets + trace.no_ops : 1;
+
+	printf("MAX7219: %lu updates", (unsigned long) trace.updates);
+	if (span > 0) {
+		printf(", %lu.%lu updates/s", (unsigned long) ((trace.updates - 1) * 1000UL / span),
+				(unsigned long) ((trace.updates - 1) * 10000UL / span % 10));
+	}
+	printf(", %lu digit bytes/update, %lu%% no-op padding, %lu control bytes\r\n",
+			(unsigned long) (trace.digit_bytes / updates),
+			(unsigned long) (trace.no_ops * 100UL / slots),
+			(unsigned long) trace.control_bytes);
+}
+
+void Max7219TraceRender(void) {
+	for (uint8_t y = 1; y <= MAX7219_SIZE; y++) {
+		for (uint8_t x = 1; x <= MAX7219_WIDTH; x++) {
+			printf("%c", TraceLed(x, y) ? '#' : '.');
+		}
+		printf("\r\n");
+	}
+}
+
+void Max7219TracePpm(void) {
+	printf("P3\n%u %u\n255\n", MAX7219_WIDTH, MAX7219_SIZE);
+	for (uint8_t y = 1; y <= MAX7219_SIZE; y++) {
+		for (uint8_t x = 1; x <= MAX7219_WIDTH; x++) {
+			printf(TraceLed(x, y) ? "255 0 0 " : "32 0 0 ");
+		}
+		printf("\n");
 	}
 }
+#endif
 
 /** @} doxygen end group definition */
@@ -0,0 +1,105 @@
+/**
+ * @file ring_buffer.c
+ * @brief Lock-free single-producer/single-consumer ring buffer for driver queues.
+ *
+ * @author
+ *   - Juan Bautista Iacobucci <link00222@gmail.com>
+ *   - Fernando Ramirez Tolentino <fernandoramireztolentino@hotmail.com>
+ *   - Lisandro Martinez <lisandromartz@gmail.com>
+ * @date 2025/03/10
+ *
+ * @copyright
+ * Released under the MIT License.
+ */
+
+/*=====[Inclusions of function dependencies]=================================*/
+
+#include "ring_buffer.h"
+
+#if defined(__arm__)
+#include "chip.h"
+/** Orders element accesses against index updates seen by the other side.
+ *  The CMSIS __DMB of LPCOpen has no memory clobber, so the compiler
+ *  barrier is explicit */
+#define RING_BARRIER() do { __asm volatile ("" ::: "memory"); __DMB(); } while (0)
+#else
+#define RING_BARRIER() __sync_synchronize()
+#endif
+
+/*=====[Function Implementations]============================================*/
+
+void RingBuffer_Init(ringBuffer_t *rb, uint16_t *storage, uint8_t size) {
+    rb->data = storage;
+    rb->mask = size - 1;
+    RingBuffer_Reset(rb);
+    RingBuffer_ClearStats(rb);
+}
+
+void RingBuffer_Reset(ringBuffer_t *rb) {
+    rb->head = 0;
+    rb->tail = 0;
+}
+
+void RingBuffer_ClearStats(ringBuffer_t *rb) {
+    rb->overflows = 0;
+    rb->high_water = 0;
+}
+
+bool RingBuffer_Push(ringBuffer_t *rb, uint16_t value) {
+    uint8_t head = rb->head;
+    uint8_t count = head - rb->tail;
+
+    if (count > rb->mask) {
+        rb->overflows++;
+        return false;
+    }
+
+    rb->data[head & rb->mask] = value;
+    RING_BARRIER();     // Element visible before the new head
+    rb->head = head + 1;
+
+    if (++count > rb->high_water) {
+        rb->high_water = count;
+    }
+    return true;
+}
+
+bool RingBuffer_Pop(ringBuffer_t *rb, uint16_t *value) {
+    uint8_t tail = rb->tail;
+
+    if (tail == rb->head) {
+        return false;
+    }
+
+    RING_BARRIER();     // Head read before the element
+    if (value != NULL) {
+        *value = rb->data[tail & rb->mask];
+    }
+    RING_BARRIER();     // Element read before the slot is released
+    rb->tail = tail + 1;
+    return true;
+}
+
+bool RingBuffer_Peek(ringBuffer_t *rb, uint8_t offset, uint16_t *value) {
+    uint8_t tail = rb->tail;
+
+    if (offset >= (uint8_t)(rb->head - tail)) {
+        return false;
+    }
+
+    RING_BARRIER();     // Head read before the element
+    *value = rb->data[(uint8_t)(tail + offset) & rb->mask];
+    return true;
+}
+
+uint8_t RingBuffer_Count(ringBuffer_t *rb) {
+    return (uint8_t)(rb->head - rb->tail);
+}
+
+bool RingBuffer_IsFull(ringBuffer_t *rb) {
+    return (uint8_t)(rb->head - rb->tail) > rb->mask;
+}
+
+bool RingBuffer_IsEmpty(ringBuffer_t *rb) {
+    return rb->head == rb->tail;
+}
@@ -6,55 +6,131 @@
 
 #include "spi_generic_device.h"
 #include "chip.h"
+#include <assert.h>
 
 /*==================[macros and definitions]=================================*/
 
 #define NONE 0
-#define MAX_PIN_INT 8
+#define THREAD 1	/**< Context() of the main loop */
+#define N_SSP 2
+
+/*==================[typedef]================================================*/
+
+/**
+ * @brief Write waiting in a batch
+ */
+typedef struct {
+	spiDevice_t *dev;
+	const uint8_t *buffer;
+	uint32_t bytes;
+	spiSelect_t select;
+	void *ctx;
+} spiBatchEntry_t;
 
 /*==================[internal data definition]===============================*/
 
 static uint8_t id_generator=NONE;
 static uint8_t last_dev_used=NONE;
-static uint8_t enabled_irqs=NONE;
-static LPC43XX_IRQn_Type interrupts[MAX_PIN_INT]={
-		PIN_INT0_IRQn,
-		PIN_INT1_IRQn,
-		PIN_INT2_IRQn,
-		PIN_INT3_IRQn,
-		PIN_INT4_IRQn,
-		PIN_INT5_IRQn,
-		PIN_INT6_IRQn,
-		PIN_INT7_IRQn
-};
+static volatile uint32_t bus_owner[N_SSP]={NONE,NONE}; /**< Context holding the bus, see Context() */
+static spiBatchEntry_t batch[N_SSP][SPI_BATCH_SIZE];
+static uint8_t batch_count[N_SSP]={0,0};
+static bool batch_lease[N_SSP]={false,false}; /**< Lease taken by the first queued write */
 
 /*==================[internal functions definition]==========================*/
 
 /**
- * @brief Enables all IRQ previously set
+ * @brief Bus counters, times in CPU cycles (DWT). Updated only by the lease
+ * owner, except 'busy' which is added to atomically
  */
-static void EnableIrqs(){
-	for(uint8_t i=0;i<MAX_PIN_INT;i++){
-		if(((enabled_irqs>>i)&0x01)){
-			NVIC_EnableIRQ(interrupts[i]);
-		}
+typedef struct {
+	uint32_t transfers;
+	uint32_t bytes;
+	uint32_t reconfigs;
+	uint64_t blocked;
+	uint32_t hold_max;
+	uint32_t busy;
+} spiBusCounters_t;
+
+static spiBusCounters_t stats[N_SSP];
+static uint32_t hold_start[N_SSP];
+
+/**
+ * @brief Current execution context: thread is 1, exceptions their number + 1
+ */
+static uint32_t Context(void){
+	return __get_IPSR()+1;
+}
+
+/**
+ * @brief Takes the bus for a blocking call. The thread waits for an ISR
+ * holding it. An ISR that finds it taken preempted the owner, which can
+ * never release it: that is a bug (use SpiDevTryLock) and asserts
+ *
+ * @return false if this context already had it (nothing to release)
+ */
+static bool Acquire(spiSsp_t n){
+	uint32_t self=Context();
+	bool taken;
+
+	if(bus_owner[n]==self){
+		return false;
 	}
+	do{
+		taken=__sync_bool_compare_and_swap(&bus_owner[n],NONE,self);
+		assert(taken || self==THREAD);
+	}while(!taken);
+	hold_start[n]=DWT->CYCCNT;
+	return true;
 }
 
 /**
- * @brief Disable all IRQ previously set
+ * @brief Releases the bus
  */
-static void DisableIrqs(){
-	for(uint8_t i=0;i<MAX_PIN_INT;i++){
-		if(((enabled_irqs>>i)&0x01)){
-			NVIC_DisableIRQ(interrupts[i]);
-		}
+static void Release(spiSsp_t n){
+	uint32_t held=DWT->CYCCNT-hold_start[n];
+
+	if(held>stats[n].hold_max){
+		stats[n].hold_max=held;
+	}
+	bus_owner[n]=NONE;
+}
+
+/**
+ * @brief Configures the SSP for the device if another one used it last
+ */
+static void Select(spiDevice_t *dev){
+	if(dev->id!=last_dev_used){
+		SpiConfig(&dev->cfg);
+		last_dev_used=dev->id;
+		stats[dev->cfg.ssp].reconfigs++;
 	}
 }
 
+/**
+ * @brief Waits for the pending DMA writes, counting the time as blocked.
+ * Call with the lease held
+ */
+static void AsyncWait(spiSsp_t n){
+	uint32_t start=DWT->CYCCNT;
+
+	SpiAsyncWait();
+	stats[n].blocked+=DWT->CYCCNT-start;
+}
+
+/**
+ * @brief Accounts a blocking transfer started at 'start' (DWT cycles)
+ */
+static void CountBlocking(spiSsp_t n, uint32_t bytes, uint32_t start){
+	stats[n].blocked+=DWT->CYCCNT-start;
+	stats[n].transfers++;
+	stats[n].bytes+=bytes;
+}
+
 /*==================[external functions definition]==========================*/
 
 void SpiDevInit(spiDevice_t *dev){
+	CoreDebug->DEMCR|=CoreDebug_DEMCR_TRCENA_Msk; /* Cycle counter for the statistics */
+	DWT->CTRL|=DWT_CTRL_CYCCNTENA_Msk;
 	id_generator++;
 	dev->id=id_generator;
 	SpiInit(dev->cfg.ssp);
@@ -68,50 +144,183 @@ void SpiDevDeInit(spiDevice_t *dev){
 }
 
 void SpiDevWriteBlocking(spiDevice_t *dev,void *buffer,uint32_t buffer_size){
-	DisableIrqs();
+	bool acquired=Acquire(dev->cfg.ssp);
+	uint32_t start;
 
-	if(dev->id!=last_dev_used){
-		SpiConfig(&dev->cfg);
-		last_dev_used=dev->id;
-	}
+	SpiDevFlush(dev->cfg.ssp);
+	AsyncWait(dev->cfg.ssp);
+	Select(dev);
+	start=DWT->CYCCNT;
 	SpiWriteBlocking(dev->cfg.ssp, buffer,  buffer_size );
+	CountBlocking(dev->cfg.ssp,buffer_size,start);
 
-	EnableIrqs();
+	if(acquired){
+		Release(dev->cfg.ssp);
+	}
 }
 
 void SpiDevReadBlocking(spiDevice_t *dev,uint8_t *buffer,uint32_t buffer_size){
-	DisableIrqs();
+	bool acquired=Acquire(dev->cfg.ssp);
+	uint32_t start;
 
-	if(dev->id!=last_dev_used){
-		SpiConfig(&dev->cfg);
-		last_dev_used=dev->id;
-	}
+	SpiDevFlush(dev->cfg.ssp);
+	AsyncWait(dev->cfg.ssp);
+	Select(dev);
+	start=DWT->CYCCNT;
 	SpiReadBlocking(dev->cfg.ssp, buffer,  buffer_size );
+	CountBlocking(dev->cfg.ssp,buffer_size,start);
 
-	EnableIrqs();
+	if(acquired){
+		Release(dev->cfg.ssp);
+	}
 }
 
 void SpiDevRWBlocking(spiDevice_t *dev, void *buffer_tx,uint8_t *buffer_rx, uint32_t bytes_to_rw ){
-	DisableIrqs();
+	bool acquired=Acquire(dev->cfg.ssp);
+	uint32_t start;
 
-	if(dev->id!=last_dev_used){
-		SpiConfig(&dev->cfg);
-		last_dev_used=dev->id;
-	}
+	SpiDevFlush(dev->cfg.ssp);
+	AsyncWait(dev->cfg.ssp);
+	Select(dev);
+	start=DWT->CYCCNT;
 	SpiRWBlocking(dev->cfg.ssp, buffer_tx,buffer_rx, bytes_to_rw );
+	CountBlocking(dev->cfg.ssp,bytes_to_rw,start);
+
+	if(acquired){
+		Release(dev->cfg.ssp);
+	}
+}
+
+void SpiDevQueueWrite(spiDevice_t *dev, const void *buffer, uint32_t bytes_to_w,
+		spiSelect_t select, void *ctx){
+	spiSsp_t n=dev->cfg.ssp;
+	spiBatchEntry_t *entry;
+
+	if(batch_count[n]==SPI_BATCH_SIZE){
+		SpiDevFlush(n);
+	}
+	if(batch_count[n]==0){
+		batch_lease[n]=Acquire(n); /* The batch is built and sent in one lease */
+	}
+	entry=&batch[n][batch_count[n]++];
+	entry->dev=dev;
+	entry->buffer=buffer;
+	entry->bytes=bytes_to_w;
+	entry->select=select;
+	entry->ctx=ctx;
+}
+
+void SpiDevFlush(spiSsp_t n){
+	spiBatchEntry_t *q=batch[n];
+	uint8_t count=batch_count[n];
+	uint8_t i=0;
+	bool acquired;
+
+	if(count==0){
+		return;
+	}
+	acquired=Acquire(n) || batch_lease[n];
+	batch_lease[n]=false;
+	batch_count[n]=0;
+	AsyncWait(n);
+
+	while(i<count){
+		spiDevice_t *dev=q[i].dev;
+
+		Select(dev); /* Once per run of writes to the same device */
+		while(i<count && q[i].dev==dev){
+			spiBatchEntry_t *first=&q[i];
+			uint32_t bytes=first->bytes;
+			uint32_t start;
 
-	EnableIrqs();
+			/* Unframed writes contiguous in memory are merged */
+			while(first->select==null && i+1<count && q[i+1].dev==dev
+					&& q[i+1].select==null && q[i+1].buffer==first->buffer+bytes){
+				i++;
+				bytes+=q[i].bytes;
+			}
+			if(first->select!=null){
+				first->select(first->ctx,true);
+			}
+			start=DWT->CYCCNT;
+			SpiWriteBlocking(n,(void *)first->buffer,bytes);
+			CountBlocking(n,bytes,start);
+			if(first->select!=null){
+				first->select(first->ctx,false);
+			}
+			i++;
+		}
+	}
+	if(acquired){
+		Release(n);
+	}
+}
+
+bool SpiDevWriteAsync(spiDevice_t *dev, spiTransfer_t *xfer){
+	spiSsp_t n=dev->cfg.ssp;
+	bool acquired=Acquire(n);
+	bool queued;
+
+	SpiDevFlush(n);
+	xfer->cfg=&dev->cfg;
+	last_dev_used=NONE; /* The transfer may configure the SSP */
+	queued=SpiWriteAsync(xfer);
+	if(queued){
+		stats[n].transfers++;
+		stats[n].bytes+=xfer->bytes;
+	}
+	if(acquired){
+		Release(n);
+	}
+	return queued;
+}
+
+void SpiDevWait(spiDevice_t *dev){
+	bool acquired=Acquire(dev->cfg.ssp); /* For the counters */
+
+	AsyncWait(dev->cfg.ssp);
+	if(acquired){
+		Release(dev->cfg.ssp);
+	}
+}
+
+bool SpiDevTryLock(spiDevice_t *dev){
+	spiSsp_t n=dev->cfg.ssp;
+
+	/* A DMA transfer holds the bus without owner */
+	if(!SpiAsyncBusy() && __sync_bool_compare_and_swap(&bus_owner[n],NONE,Context())){
+		hold_start[n]=DWT->CYCCNT;
+		return true;
+	}
+	__sync_fetch_and_add(&stats[n].busy,1); /* Without the lease */
+	return false;
+}
+
+void SpiDevUnlock(spiDevice_t *dev){
+	Release(dev->cfg.ssp);
 }
 
-void SpiDevSetIrqList(uint8_t irq){
-	if(irq<8){
-		enabled_irqs|=(0x01<<irq);
+void SpiDevGetStats(spiSsp_t n, spiBusStats_t *s){
+	uint32_t cycles_us=SystemCoreClock/1000000;
+	bool acquired=Acquire(n); /* No update halfway through the copy */
+
+	s->transfers=stats[n].transfers;
+	s->bytes=stats[n].bytes;
+	s->reconfigs=stats[n].reconfigs;
+	s->blocked_us=(uint32_t)(stats[n].blocked/cycles_us);
+	s->hold_us_max=stats[n].hold_max/cycles_us;
+	s->busy=stats[n].busy;
+	if(acquired){
+		Release(n);
 	}
 }
 
-void SpiDevClearIrqList(uint8_t irq){
-	if(irq<8){
-		enabled_irqs&=~(0x01<<irq);
+void SpiDevClearStats(spiSsp_t n){
+	bool acquired=Acquire(n);
+
+	stats[n]=(spiBusCounters_t){ 0 };
+	if(acquired){
+		Release(n);
 	}
 }
 
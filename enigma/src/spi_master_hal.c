@@ -11,6 +11,13 @@
 
 #define N_CONFIG  3
 
+/* DMA interrupt priority: below the PS/2 interrupts (5), above the gray
+ * scale timer (7) that waits on the queue */
+#define DMA_PRIORITY 6
+
+/* Transfer width bits of a DMA channel control word */
+#define DMA_WIDTH_MASK	(GPDMA_DMACCxControl_SWidth(0x07) | GPDMA_DMACCxControl_DWidth(0x07))
+
 /*==================[typedef]================================================*/
 
 /**
@@ -45,6 +52,113 @@ static const sspCfg_t ssp_1_cfg[] = {
 
 static const sspCfg_t* ssp_cfg[] = { null, ssp_1_cfg };
 
+/* Asynchronous transfers. Queued by the application, completed by the DMA interrupt */
+static spiTransfer_t *xfer_queue[SPI_QUEUE_SIZE];
+static volatile uint8_t xfer_head = 0;	/**< Running transfer */
+static volatile uint8_t xfer_count = 0;	/**< Running + waiting transfers */
+static spiConfig_t *last_cfg = null;	/**< Configuration the SSP has */
+
+#if defined(SPI_DMA_SIM)
+static uint32_t sim_left_us = 0;		/**< Bus time left of the running transfer */
+#else
+static const uint32_t dma_conn[] = { GPDMA_CONN_SSP0_Tx, GPDMA_CONN_SSP1_Tx };
+static const uint32_t dma_conn_rx[] = { GPDMA_CONN_SSP0_Rx, GPDMA_CONN_SSP1_Rx };
+static uint8_t dma_channel;			/**< Memory to SSP */
+static uint8_t dma_channel_rx;		/**< SSP to dma_sink, ends the transfer */
+static uint16_t dma_sink;			/**< Discarded received frames */
+static bool dma_ready = false;
+#endif
+
+/*==================[internal functions definition]==========================*/
+
+#if !defined(SPI_DMA_SIM)
+/**
+ * @brief Takes the DMA channels for all the asynchronous transfers
+ */
+static void DmaInit(void) {
+	Chip_GPDMA_Init(LPC_GPDMA);
+	dma_channel = Chip_GPDMA_GetFreeChannel(LPC_GPDMA, GPDMA_CONN_SSP1_Tx);
+	dma_channel_rx = Chip_GPDMA_GetFreeChannel(LPC_GPDMA, GPDMA_CONN_SSP1_Rx);
+	NVIC_SetPriority(DMA_IRQn, DMA_PRIORITY);
+	NVIC_EnableIRQ(DMA_IRQn);
+	dma_ready = true;
+}
+#endif
+
+/**
+ * @brief Starts the transfer at the head of the queue
+ */
+static void StartTransfer(spiTransfer_t *x) {
+	if (x->cfg != last_cfg) {
+#if !defined(SPI_DMA_SIM)
+		SpiConfig(x->cfg);
+#endif
+		last_cfg = x->cfg;
+	}
+	if (x->on_start != null) {
+		x->on_start(x->ctx);
+	}
+#if defined(SPI_DMA_SIM)
+	/* Bus time, rounded up */
+	sim_left_us = (uint32_t) (((uint64_t) x->bytes * 8 * 1000000
+			+ x->cfg->clock_freq - 1) / x->cfg->clock_freq);
+#else
+	DMA_TransferDescriptor_t desc;
+	DMA_TransferDescriptor_t desc_rx;
+	bool wide = (x->cfg->bits == SPI_BITS16);
+	uint32_t frames = wide ? x->bytes / 2 : x->bytes;
+
+	/* A frame is received when it has been shifted out, so the end of the
+	 * RX transfer is the end of the bus transfer */
+	while (Chip_SSP_GetStatus(ssp[x->cfg->ssp], SSP_STAT_RNE) == SET) {
+		Chip_SSP_ReceiveFrame(ssp[x->cfg->ssp]);
+	}
+	Chip_GPDMA_PrepareDescriptor(LPC_GPDMA, &desc, (uint32_t) x->tx,
+			dma_conn[x->cfg->ssp], frames,
+			GPDMA_TRANSFERTYPE_M2P_CONTROLLER_DMA, null);
+	Chip_GPDMA_PrepareDescriptor(LPC_GPDMA, &desc_rx, dma_conn_rx[x->cfg->ssp],
+			(uint32_t) &dma_sink, frames,
+			GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA, null);
+	desc.ctrl &= ~GPDMA_DMACCxControl_I;		/* Only the RX end interrupts */
+	desc_rx.ctrl &= ~GPDMA_DMACCxControl_DI;	/* Every frame to dma_sink */
+	if (wide) {
+		/* The connection table assumes byte frames */
+		desc.ctrl = (desc.ctrl & ~DMA_WIDTH_MASK)
+				| GPDMA_DMACCxControl_SWidth(GPDMA_WIDTH_HALFWORD)
+				| GPDMA_DMACCxControl_DWidth(GPDMA_WIDTH_HALFWORD);
+		desc_rx.ctrl = (desc_rx.ctrl & ~DMA_WIDTH_MASK)
+				| GPDMA_DMACCxControl_SWidth(GPDMA_WIDTH_HALFWORD)
+				| GPDMA_DMACCxControl_DWidth(GPDMA_WIDTH_HALFWORD);
+	}
+	Chip_SSP_DMA_Enable(ssp[x->cfg->ssp]);
+	Chip_GPDMA_SGTransfer(LPC_GPDMA, dma_channel_rx, &desc_rx,
+			GPDMA_TRANSFERTYPE_P2M_CONTROLLER_DMA);
+	Chip_GPDMA_SGTransfer(LPC_GPDMA, dma_channel, &desc,
+			GPDMA_TRANSFERTYPE_M2P_CONTROLLER_DMA);
+#endif
+}
+
+/**
+ * @brief Finishes the running transfer and starts the next one
+ */
+static void TransferDone(void) {
+	spiTransfer_t *x = xfer_queue[xfer_head];
+
+#if !defined(SPI_DMA_SIM)
+	/* The last frame has been received, the bus is idle */
+	Chip_SSP_DMA_Disable(ssp[x->cfg->ssp]);
+#endif
+	xfer_head = (xfer_head + 1) % SPI_QUEUE_SIZE;
+	xfer_count--;
+
+	if (x->on_done != null) {
+		x->on_done(x->ctx);
+	}
+	if (xfer_count > 0) {
+		StartTransfer(xfer_queue[xfer_head]);
+	}
+}
+
 /*==================[external functions definition]==========================*/
 
 void SpiInit(spiSsp_t n) {
@@ -71,6 +185,7 @@ void SpiDeInit(spiSsp_t n) {
 }
 
 void SpiConfig(spiConfig_t *cfg) {
+	last_cfg = cfg;
 	Chip_SSP_SetFormat(ssp[cfg->ssp], bits[cfg->bits], SSP_FRAMEFORMAT_SPI,
 			clock_mode[cfg->clock_mode]);
 	Chip_SSP_SetBitRate(ssp[cfg->ssp], cfg->clock_freq);
@@ -119,3 +234,63 @@ void SpiTestLoopBack(spiSsp_t n, bool enable) {
 
 }
 
+bool SpiWriteAsync(spiTransfer_t *xfer) {
+#if !defined(SPI_DMA_SIM)
+	if (dma_ready == false) {
+		DmaInit();
+	}
+#endif
+	NVIC_DisableIRQ(DMA_IRQn);
+	if (xfer_count >= SPI_QUEUE_SIZE) {
+		NVIC_EnableIRQ(DMA_IRQn);
+		return false;
+	}
+	xfer_queue[(xfer_head + xfer_count) % SPI_QUEUE_SIZE] = xfer;
+	if (xfer_count++ == 0) {
+		StartTransfer(xfer);
+	}
+	NVIC_EnableIRQ(DMA_IRQn);
+	return true;
+}
+
+bool SpiAsyncBusy(void) {
+	return xfer_count > 0;
+}
+
+void SpiAsyncWait(void) {
+#if defined(SPI_DMA_SIM)
+	while (xfer_count > 0) {
+		SpiDmaSimAdvance(sim_left_us);
+	}
+#else
+	while (xfer_count > 0);
+#endif
+}
+
+#if defined(SPI_DMA_SIM)
+void SpiDmaSimAdvance(uint32_t us) {
+	while (xfer_count > 0) {
+		if (us < sim_left_us) {
+			sim_left_us -= us;
+			return;
+		}
+		us -= sim_left_us;
+		sim_left_us = 0;
+		TransferDone();
+	}
+}
+#else
+void DMA_IRQHandler(void) {
+	if (Chip_GPDMA_IntGetStatus(LPC_GPDMA, GPDMA_STAT_INT, dma_channel)) {
+		/* TX only interrupts on error, the RX end would never come */
+		Chip_GPDMA_Interrupt(LPC_GPDMA, dma_channel);
+		Chip_GPDMA_ChannelCmd(LPC_GPDMA, dma_channel_rx, DISABLE);
+		Chip_GPDMA_Interrupt(LPC_GPDMA, dma_channel_rx);
+		TransferDone();
+	} else if (Chip_GPDMA_IntGetStatus(LPC_GPDMA, GPDMA_STAT_INT, dma_channel_rx)) {
+		/* Terminal count or error, the transfer is over either way */
+		Chip_GPDMA_Interrupt(LPC_GPDMA, dma_channel_rx);
+		TransferDone();
+	}
+}
+#endif
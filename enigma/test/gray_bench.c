@@ -0,0 +1,200 @@
+/**
+ * @file gray_bench.c
+ * @brief Host run of the gray scale display: TIMER1_IRQHandler() at the
+ * match period MatrixGrayStart() programs, over the real SPI master HAL
+ * built with SPI_DMA_SIM, so plane switches wait on the simulated bus.
+ *
+ * Time goes in 1 us steps. Each step completes the DMA transfers whose bus
+ * time has elapsed (DMA interrupt context), then runs the timer interrupt
+ * if its match is due. The main loop runs once per millisecond, between
+ * steps. IPSR reads the running exception so the SPI lease sees the ISRs.
+ *
+ * Checks the commit handshake on a matrix of its own, then plays the
+ * loading clip in gray and prints the display counters. Build and run with
+ * `make gray`, MATRIX_GRAY_HZ with `make gray GRAY_HZ=250`.
+ *
+ * @copyright
+ * Released under the MIT License.
+ */
+
+/*=====[Inclusions of function dependencies]=================================*/
+
+#include <stdio.h>
+#include "sapi.h"
+#include "animation.h"
+#include "led_matrix.h"
+#include "spi_master_hal.h"
+
+/*=====[Definition macros of private constants]==============================*/
+
+#define EXC_IRQ0 16     // Exception number of IRQ 0
+#define RUN_MS   1000   // Loading clip is 800 ms
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("%s:%d: %s\n", __FILE__, __LINE__, #cond); \
+            failures++; \
+        } \
+    } while (0)
+
+/*=====[Prototypes (declarations) of external functions]=====================*/
+
+/* Vector table entry on target */
+void TIMER1_IRQHandler(void);
+
+/*=====[Definitions of private global variables]=============================*/
+
+static int failures = 0;
+
+static uint32_t now_us = 0;
+static uint32_t timer_us = 0;   // Time since the last match
+
+/* Two level ramps, bit k of every pixel level in planes[k] */
+static const uint64_t rampA[MATRIX_GRAY_PLANES] = {
+    0xAAAAAAAAAAAAAAAAULL, 0xCCCCCCCCCCCCCCCCULL,
+#if MATRIX_GRAY_PLANES > 2
+    0xF0F0F0F0F0F0F0F0ULL,
+#endif
+};
+static const uint64_t rampB[MATRIX_GRAY_PLANES] = {
+    0xFF00FF00FF00FF00ULL, 0xFFFF0000FFFF0000ULL,
+#if MATRIX_GRAY_PLANES > 2
+    0xFFFFFFFF00000000ULL,
+#endif
+};
+
+/*=====[Implementations of private functions]================================*/
+
+static bool_t IrqEnabled(IRQn_Type irq) {
+    return (NVIC->ISER[(uint32_t)irq >> 5] >> ((uint32_t)irq & 0x1F)) & 1;
+}
+
+/* Match period MatrixGrayStart() programmed, in us */
+static uint32_t TimerPeriodUs(void) {
+    return LPC_TIMER1->MR[0] / (SystemCoreClock / 1000000);
+}
+
+/* One microsecond: DMA completions first, then the timer interrupt */
+static void Step(void) {
+    now_us++;
+    DWT->CYCCNT += SystemCoreClock / 1000000;
+
+    host_ipsr = EXC_IRQ0 + DMA_IRQn;
+    SpiDmaSimAdvance(1);
+    host_ipsr = 0;
+
+    if (!IrqEnabled(TIMER1_IRQn)) {
+        timer_us = 0;
+        return;
+    }
+    if (++timer_us >= TimerPeriodUs()) {
+        timer_us = 0;
+        LPC_TIMER1->IR |= 1;
+        host_ipsr = EXC_IRQ0 + TIMER1_IRQn;
+        TIMER1_IRQHandler();
+        host_ipsr = 0;
+    }
+}
+
+/* Runs the interrupts until the next millisecond */
+static void Millisecond(void) {
+    do {
+        Step();
+    } while (now_us % 1000 != 0);
+    hostAdvance(1);
+}
+
+/* Runs the interrupts until the next bit plane cycle starts */
+static void NextCycle(ledMatrix_t *mat) {
+    uint32_t cycles = mat->stats.gray_cycles;
+
+    while (mat->stats.gray_cycles == cycles)
+        Step();
+}
+
+/* Planes on display are the drawing planes */
+static bool_t FrontIsDrawn(ledMatrix_t *mat) {
+    for (uint8_t k = 0; k < MATRIX_GRAY_PLANES; k++)
+        if (mat->gray_front[k][0] != mat->gray[k][0])
+            return false;
+    return true;
+}
+
+/*
+ * Drawn planes reach the display at the start of the cycle after
+ * MatrixUpdate, never while they are being drawn
+ */
+static void test_handshake(void) {
+    max7219_t dev;
+    static ledMatrix_t mat;
+    max7219Stats_t d;
+    uint64_t shown;
+    uint32_t late;
+    uint8_t i;
+
+    Max7219Init(&dev, GPIO0, max7219_spi_default_cfg);
+    MatrixInit(&mat, dev, ROT_0_CW);
+    MatrixSetGrayImage(&mat, 0, rampA);
+    MatrixGrayStart(&mat);
+    NextCycle(&mat);
+    CHECK(FrontIsDrawn(&mat));
+    shown = mat.gray_front[0][0];
+
+    // Drawn but not committed: the ISR keeps showing the last commit
+    MatrixSetGrayImage(&mat, 0, rampB);
+    NextCycle(&mat);
+    NextCycle(&mat);
+    CHECK(mat.gray_front[0][0] == shown && !FrontIsDrawn(&mat));
+
+    // Committed halfway through a cycle: taken at the next one
+    Step();
+    MatrixUpdate(&mat);
+    CHECK(mat.gray_front[0][0] == shown);
+    NextCycle(&mat);
+    CHECK(FrontIsDrawn(&mat) && !mat.gray_commit);
+
+    // Bus load of a still image, Max7219Update sends the changed rows only
+    Max7219ClearStats(&mat.dev);
+    late = mat.stats.gray_late;
+    for (i = 0; i < 10; i++)
+        NextCycle(&mat);
+    Max7219GetStats(&mat.dev, &d);
+    printf("Gray ramp: %lu row frames per cycle, %lu late switches in 10 cycles\n",
+           (unsigned long)(d.frames / 10), (unsigned long)(mat.stats.gray_late - late));
+
+    MatrixGrayStop(&mat);
+    CHECK(!IrqEnabled(TIMER1_IRQn));
+    SpiAsyncWait();
+}
+
+/* Loading clip in gray, the main loop as FSM.c runs it */
+static void run_loading(void) {
+    uint32_t ms;
+
+    Animation_Init();
+    SpiAsyncWait();
+    Animation_ResetStats();
+    for (ms = 0; ms < RUN_MS; ms++) {
+        Animation_Loading(false);
+        Animation_Update();
+        Millisecond();
+    }
+    CHECK(IrqEnabled(TIMER1_IRQn));  // Still in gray, nothing else drew
+
+    printf("Gray: %u Hz, %u us per time unit\n", MATRIX_GRAY_HZ, (unsigned)TimerPeriodUs());
+    Animation_PrintStats();
+
+    Animation_DrawCharacter('A');  // Takes the display back
+    CHECK(!IrqEnabled(TIMER1_IRQn));
+}
+
+/*=====[Main function, program entry point after power on or reset]==========*/
+
+int main(void) {
+    test_handshake();
+    run_loading();
+
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,250 @@
+/**
+ * @file chip.h
+ * @brief Host stand-in for the LPCOpen/CMSIS symbols used by the modules
+ * built on the host: the DWT cycle counter, IPSR, the core clock, the NVIC
+ * enable bits, the GPIO byte registers, the pin interrupt fall flags, the
+ * RIT, TIMER1 match 0 and the SSP (blocking transfers advance the cycle
+ * counter by their bus time). Calls with no effect on the host are empty
+ * inlines.
+ *
+ * @copyright
+ * Released under the MIT License.
+ */
+
+#ifndef __HOST_CHIP_H__
+#define __HOST_CHIP_H__
+
+/*=====[Inclusions of public function dependencies]==========================*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*=====[Definitions of public data types]====================================*/
+
+typedef enum {
+    DMA_IRQn      = 2,
+    RITIMER_IRQn  = 11,
+    TIMER1_IRQn   = 13,
+    PIN_INT0_IRQn = 32,
+} IRQn_Type;
+
+typedef struct {
+    volatile uint32_t ISER[8];  /**< Enable bits, set and cleared by NVIC_Enable/DisableIRQ */
+} NVIC_Type;
+
+typedef struct {
+    volatile uint8_t B[8][32];  /**< Byte pin registers, port then bit */
+} LPC_GPIO_T;
+
+typedef struct {
+    volatile uint32_t FALL;     /**< Falling edge flags, set by the test before calling the ISR */
+} LPC_PIN_INT_T;
+
+typedef struct {
+    volatile uint32_t COUNTER;
+} LPC_RITIMER_T;
+
+typedef struct {
+    volatile uint32_t IR;       /**< Match 0 flag in bit 0, set by the test before calling the ISR */
+    volatile uint32_t MR[4];
+} LPC_TIMER_T;
+
+typedef struct {
+    uint32_t bitrate;           /**< Set by Chip_SSP_SetBitRate */
+} LPC_SSP_T;
+
+typedef struct {
+    void *tx_data;
+    uint32_t tx_cnt;
+    void *rx_data;
+    uint32_t rx_cnt;
+    uint32_t length;
+} Chip_SSP_DATA_SETUP_T;
+
+typedef struct {
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;   /**< Advanced by the bus time of each SPI write */
+} DWT_Type;
+
+typedef struct {
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+/*=====[Public function-like macros]=========================================*/
+
+#define DWT_CTRL_CYCCNTENA_Msk      (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk  (1UL << 24)
+
+#define DWT       (&host_dwt)
+#define CoreDebug (&host_core_debug)
+#define NVIC      (&host_nvic)
+
+#define LPC_GPIO_PORT    (&host_gpio_port)
+#define LPC_GPIO_PIN_INT (&host_pin_int)
+#define LPC_RITIMER      (&host_ritimer)
+#define LPC_TIMER1       (&host_timer1)
+#define LPC_SSP0         (&host_ssp[0])
+#define LPC_SSP1         (&host_ssp[1])
+
+#define PININTCH(ch)     (1UL << (ch))
+#define CLK_MX_RITIMER   0
+#define CLK_MX_TIMER1    1
+#define RIT_CTRL_ENCLR   (1UL << 1)
+
+#define SSP_BITS_8            7
+#define SSP_BITS_16           15
+#define SSP_FRAMEFORMAT_SPI   0
+#define SSP_CLOCK_CPHA0_CPOL0 0
+#define SSP_CLOCK_CPHA0_CPOL1 (1 << 6)
+#define SSP_CLOCK_CPHA1_CPOL0 (1 << 7)
+#define SSP_CLOCK_CPHA1_CPOL1 ((1 << 6) | (1 << 7))
+#define SCU_MODE_PULLUP       0
+#define SCU_MODE_INBUFF_EN    (1 << 6)
+#define SCU_MODE_ZIF_DIS      (1 << 7)
+#define SCU_MODE_FUNC1        1
+#define SCU_MODE_FUNC5        5
+
+/*=====[Prototypes (declarations) of public data]============================*/
+
+extern DWT_Type host_dwt;
+extern CoreDebug_Type host_core_debug;
+extern NVIC_Type host_nvic;
+extern LPC_GPIO_T host_gpio_port;
+extern LPC_PIN_INT_T host_pin_int;
+extern LPC_RITIMER_T host_ritimer;
+extern LPC_TIMER_T host_timer1;
+extern LPC_SSP_T host_ssp[2];
+extern uint32_t host_nvic_masks[64]; /**< NVIC_DisableIRQ calls per IRQ */
+extern uint32_t host_ipsr;      /**< Exception number __get_IPSR() returns, 0 for thread */
+extern uint32_t SystemCoreClock;
+
+/*=====[Prototypes (declarations) of public functions]=======================*/
+
+/** Thread context unless a test sets host_ipsr around an ISR call */
+static inline uint32_t __get_IPSR(void) {
+    return host_ipsr;
+}
+
+static inline void __DMB(void) {
+    __sync_synchronize();
+}
+
+static inline void NVIC_EnableIRQ(IRQn_Type irq) {
+    NVIC->ISER[(uint32_t)irq >> 5] |= 1UL << ((uint32_t)irq & 0x1F);
+}
+
+static inline void NVIC_DisableIRQ(IRQn_Type irq) {
+    host_nvic_masks[irq]++;
+    NVIC->ISER[(uint32_t)irq >> 5] &= ~(1UL << ((uint32_t)irq & 0x1F));
+}
+
+static inline void NVIC_ClearPendingIRQ(IRQn_Type irq) {
+}
+
+static inline void NVIC_SetPriority(IRQn_Type irq, uint32_t priority) {
+}
+
+static inline void Chip_SCU_GPIOIntPinSel(uint8_t ch, uint8_t port, uint8_t pin) {
+}
+
+static inline uint32_t Chip_PININT_GetFallStates(LPC_PIN_INT_T *pint) {
+    return pint->FALL;
+}
+
+static inline void Chip_PININT_ClearIntStatus(LPC_PIN_INT_T *pint, uint32_t mask) {
+    pint->FALL &= ~mask;
+}
+
+static inline void Chip_PININT_SetPinModeEdge(LPC_PIN_INT_T *pint, uint32_t mask) {
+}
+
+static inline void Chip_PININT_EnableIntLow(LPC_PIN_INT_T *pint, uint32_t mask) {
+}
+
+static inline uint32_t Chip_Clock_GetRate(uint32_t clk) {
+    return SystemCoreClock;
+}
+
+static inline void Chip_RIT_Init(LPC_RITIMER_T *rit) {
+}
+
+static inline void Chip_RIT_Enable(LPC_RITIMER_T *rit) {
+}
+
+static inline void Chip_RIT_Disable(LPC_RITIMER_T *rit) {
+}
+
+static inline void Chip_RIT_ClearInt(LPC_RITIMER_T *rit) {
+}
+
+static inline void Chip_RIT_SetCOMPVAL(LPC_RITIMER_T *rit, uint32_t val) {
+}
+
+static inline void Chip_RIT_EnableCTRL(LPC_RITIMER_T *rit, uint32_t mask) {
+}
+
+static inline void Chip_TIMER_Init(LPC_TIMER_T *timer) {
+}
+
+static inline void Chip_TIMER_DeInit(LPC_TIMER_T *timer) {
+}
+
+static inline void Chip_TIMER_Reset(LPC_TIMER_T *timer) {
+}
+
+static inline void Chip_TIMER_Enable(LPC_TIMER_T *timer) {
+}
+
+static inline void Chip_TIMER_Disable(LPC_TIMER_T *timer) {
+}
+
+static inline void Chip_TIMER_MatchEnableInt(LPC_TIMER_T *timer, int8_t match) {
+}
+
+static inline void Chip_TIMER_ResetOnMatchEnable(LPC_TIMER_T *timer, int8_t match) {
+}
+
+static inline void Chip_TIMER_SetMatch(LPC_TIMER_T *timer, int8_t match, uint32_t val) {
+    timer->MR[match] = val;
+}
+
+static inline bool Chip_TIMER_MatchPending(LPC_TIMER_T *timer, int8_t match) {
+    return (timer->IR >> match) & 1;
+}
+
+static inline void Chip_TIMER_ClearMatch(LPC_TIMER_T *timer, int8_t match) {
+    timer->IR &= ~(1UL << match);
+}
+
+static inline void Chip_SCU_PinMuxSet(uint8_t port, uint8_t pin, uint16_t func) {
+}
+
+static inline void Chip_SSP_Init(LPC_SSP_T *ssp) {
+}
+
+static inline void Chip_SSP_DeInit(LPC_SSP_T *ssp) {
+}
+
+static inline void Chip_SSP_Enable(LPC_SSP_T *ssp) {
+}
+
+static inline void Chip_SSP_EnableLoopBack(LPC_SSP_T *ssp) {
+}
+
+static inline void Chip_SSP_DisableLoopBack(LPC_SSP_T *ssp) {
+}
+
+static inline void Chip_SSP_SetFormat(LPC_SSP_T *ssp, uint32_t bits, uint32_t format, uint32_t mode) {
+}
+
+static inline void Chip_SSP_SetBitRate(LPC_SSP_T *ssp, uint32_t bitrate) {
+    ssp->bitrate = bitrate;
+}
+
+static inline uint32_t Chip_SSP_RWFrames_Blocking(LPC_SSP_T *ssp, Chip_SSP_DATA_SETUP_T *xfer) {
+    if (ssp->bitrate > 0)
+        DWT->CYCCNT += (uint32_t)((uint64_t)xfer->length * 8 * SystemCoreClock / ssp->bitrate);
+    return xfer->length;
+}
+
+#endif /* __HOST_CHIP_H__ */
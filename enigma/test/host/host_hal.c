@@ -0,0 +1,105 @@
+/**
+ * @file host_hal.c
+ * @brief Host sAPI and chip stand-ins for the display and PS/2 modules.
+ *
+ * Time is a millisecond counter moved by hostAdvance(). GPIO pins only
+ * remember their direction and output level. The SPI master HAL is either
+ * host_spi.c or the real one built with SPI_DMA_SIM.
+ *
+ * @copyright
+ * Released under the MIT License.
+ */
+
+/*=====[Inclusions of function dependencies]=================================*/
+
+#include "sapi.h"
+#include "chip.h"
+
+/*=====[Definitions of public global variables]==============================*/
+
+DWT_Type host_dwt;
+CoreDebug_Type host_core_debug;
+NVIC_Type host_nvic;
+LPC_GPIO_T host_gpio_port;
+LPC_PIN_INT_T host_pin_int;
+LPC_RITIMER_T host_ritimer;
+LPC_TIMER_T host_timer1;
+LPC_SSP_T host_ssp[2];
+uint32_t host_nvic_masks[64];
+uint32_t host_ipsr = 0;
+uint32_t SystemCoreClock = 204000000;
+
+/* Every host pin on port 3, bit = map index */
+pinInitGpioLpc4337_t gpioPinsInit[HOST_GPIO_COUNT] = {
+    [ENET_RXD1] = { { 3, ENET_RXD1 } },
+    [GPIO0]     = { { 3, GPIO0 } },
+    [T_COL2]    = { { 3, T_COL2 } },
+    [T_FIL1]    = { { 3, T_FIL1 } },
+    [LED3]      = { { 3, LED3 } },
+};
+
+/*=====[Definitions of private global variables]=============================*/
+
+static tick_t now = 0;                  // Simulated time, ms
+static uint32_t cs_frames = 0;          // Chip select pulses (rising edges)
+static bool_t gpio_out[HOST_GPIO_COUNT];   // Pin configured as output
+static bool_t gpio_level[HOST_GPIO_COUNT]; // Output level
+
+/*=====[Implementations of public functions]=================================*/
+
+bool_t gpioInit(gpioMap_t pin, gpioInit_t config) {
+    return gpioConfig(pin, config);
+}
+
+bool_t gpioConfig(gpioMap_t pin, gpioInit_t config) {
+    gpio_out[pin] = (config == GPIO_OUTPUT);
+    return true;
+}
+
+bool_t gpioWrite(gpioMap_t pin, bool_t value) {
+    if (pin == ENET_RXD1 && value && !gpio_level[pin])
+        cs_frames++;
+    gpio_level[pin] = value;
+    return true;
+}
+
+bool_t gpioRead(gpioMap_t pin) {
+    return gpio_out[pin] ? gpio_level[pin] : true;  // Inputs read their pull-up
+}
+
+bool_t hostGpioDriven(gpioMap_t pin) {
+    return gpio_out[pin];
+}
+
+void delayInaccurateUs(tick_t delay_us) {
+}
+
+tick_t tickRead(void) {
+    return now;
+}
+
+void hostAdvance(tick_t ms) {
+    now += ms;
+}
+
+uint32_t hostFrames(void) {
+    return cs_frames;
+}
+
+void delayInit(delay_t *delay, tick_t duration) {
+    delay->duration = duration;
+    delay->running = false;
+}
+
+bool_t delayRead(delay_t *delay) {
+    if (!delay->running) {
+        delay->startTime = now;
+        delay->running = true;
+        return false;
+    }
+    if (now - delay->startTime >= delay->duration) {
+        delay->running = false;
+        return true;
+    }
+    return false;
+}
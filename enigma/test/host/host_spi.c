@@ -0,0 +1,70 @@
+/**
+ * @file host_spi.c
+ * @brief Host SPI master HAL stand-in for the display trace.
+ *
+ * SPI writes go nowhere, the MAX7219 trace decodes them before they get
+ * here. Each write advances the DWT cycle counter by its bus time, so the
+ * bus statistics read as on target. DMA writes complete at once.
+ *
+ * @copyright
+ * Released under the MIT License.
+ */
+
+/*=====[Inclusions of function dependencies]=================================*/
+
+#include "chip.h"
+#include "spi_master_hal.h"
+
+/*=====[Definitions of private global variables]=============================*/
+
+static uint32_t clock_freq = 1000000;   // Bus clock of the last configuration
+
+/*=====[Implementations of private functions]================================*/
+
+static void BusTime(uint32_t bytes) {
+    host_dwt.CYCCNT += (uint32_t)((uint64_t)bytes * 8 * SystemCoreClock / clock_freq);
+}
+
+/*=====[Implementations of public functions]=================================*/
+
+void SpiInit(spiSsp_t n) {
+}
+
+void SpiDeInit(spiSsp_t n) {
+}
+
+void SpiConfig(spiConfig_t *cfg) {
+    clock_freq = cfg->clock_freq;
+}
+
+void SpiReadBlocking(spiSsp_t n, uint8_t *buffer, uint32_t bytes_to_r) {
+    BusTime(bytes_to_r);
+}
+
+void SpiWriteBlocking(spiSsp_t n, void *buffer, uint32_t bytes_to_w) {
+    BusTime(bytes_to_w);
+}
+
+void SpiRWBlocking(spiSsp_t n, void *buffer_tx, uint8_t *buffer_rx, uint32_t bytes_to_rw) {
+    BusTime(bytes_to_rw);
+}
+
+void SpiTestLoopBack(spiSsp_t n, bool enable) {
+}
+
+bool SpiWriteAsync(spiTransfer_t *xfer) {
+    if (xfer->on_start != null) {
+        xfer->on_start(xfer->ctx);
+    }
+    if (xfer->on_done != null) {
+        xfer->on_done(xfer->ctx);
+    }
+    return true;
+}
+
+bool SpiAsyncBusy(void) {
+    return false;
+}
+
+void SpiAsyncWait(void) {
+}
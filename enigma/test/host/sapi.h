@@ -0,0 +1,67 @@
+/**
+ * @file sapi.h
+ * @brief Host stand-in for the sAPI declarations used by the display and
+ * PS/2 modules. Implemented in host_hal.c over a simulated millisecond
+ * clock; pins keep their direction and level so tests can read them back.
+ *
+ * @copyright
+ * Released under the MIT License.
+ */
+
+#ifndef __HOST_SAPI_H__
+#define __HOST_SAPI_H__
+
+/*=====[Inclusions of public function dependencies]==========================*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "chip.h"
+
+/*=====[Definitions of public data types]====================================*/
+
+typedef uint8_t bool_t;
+typedef uint64_t tick_t;
+
+typedef enum { ENET_RXD1, GPIO0, T_COL2, T_FIL1, LED3, HOST_GPIO_COUNT } gpioMap_t;
+typedef enum { GPIO_INPUT, GPIO_OUTPUT, GPIO_INPUT_PULLUP } gpioInit_t;
+
+typedef struct {
+    struct {
+        uint8_t port;
+        uint8_t pin;
+    } gpio;     /**< Bit of the pin in LPC_GPIO_PORT->B */
+} pinInitGpioLpc4337_t;
+
+#define ON  1
+#define OFF 0
+
+typedef struct {
+    tick_t startTime;
+    tick_t duration;
+    bool_t running;
+} delay_t;
+
+/*=====[Prototypes (declarations) of public functions]=======================*/
+
+bool_t gpioInit(gpioMap_t pin, gpioInit_t config);
+bool_t gpioConfig(gpioMap_t pin, gpioInit_t config);
+bool_t gpioWrite(gpioMap_t pin, bool_t value);
+bool_t gpioRead(gpioMap_t pin);
+
+tick_t tickRead(void);
+void delayInaccurateUs(tick_t delay_us);
+
+void delayInit(delay_t *delay, tick_t duration);
+bool_t delayRead(delay_t *delay);
+
+/** Moves the simulated clock forward (host only) */
+void hostAdvance(tick_t ms);
+
+/** Frames sent so far, counted on the chip select going high (host only) */
+uint32_t hostFrames(void);
+
+/** Whether the firmware drives the pin, rather than leaving it to its pull-up (host only) */
+bool_t hostGpioDriven(gpioMap_t pin);
+
+#endif /* __HOST_SAPI_H__ */
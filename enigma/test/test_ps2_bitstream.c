@@ -0,0 +1,310 @@
+/**
+ * @file test_ps2_bitstream.c
+ * @brief Host tests of the PS/2 driver: synthetic clock/data bitstreams go
+ * through GPIO0_IRQHandler(), one call per falling clock edge, with the
+ * PININT flags and GPIO byte registers shimmed (host/chip.h).
+ *
+ * A small keyboard model clocks out whatever the driver sends (RESEND,
+ * commands) and answers it, so the resend and command paths run too.
+ * Build and run with `make` in this directory.
+ *
+ * @copyright
+ * Released under the MIT License.
+ */
+
+/*=====[Inclusions of function dependencies]=================================*/
+
+#include <stdio.h>
+#include "sapi.h"
+#include "PS2Keyboard.h"
+#include "PS2KeyCode.h"
+
+/*=====[Definition macros of private constants]==============================*/
+
+#define DATA_PIN  T_FIL1
+#define CLOCK_PIN T_COL2
+
+#define PARITY_ERROR 0x01   // Wrong parity bit, driver must request a resend
+#define GLITCH       0x02   // Aborted bogus frame before the real one
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("%s:%d: %s\n", __FILE__, __LINE__, #cond); \
+            failures++; \
+        } \
+    } while (0)
+
+/*=====[Definitions of private data types]===================================*/
+
+/* One scenario: scan code bytes in and the translated keys expected out */
+typedef struct {
+    const char *name;
+    uint8_t codes[8];
+    uint8_t len;
+    uint8_t faults;     // Faults applied to the first frame
+    uint16_t keys[2];
+    uint8_t nkeys;
+} simCase_t;
+
+/*=====[Prototypes (declarations) of external functions]=====================*/
+
+/* Vector table entries on target */
+void GPIO0_IRQHandler(void);
+void RIT_IRQHandler(void);
+
+extern pinInitGpioLpc4337_t gpioPinsInit[];
+
+/*=====[Definitions of private global variables]=============================*/
+
+static const simCase_t sim_cases[] = {
+    { "make",       { 0x1C }, 1, 0,
+      { PS2_KEY_A }, 1 },
+    { "make/break", { 0x1C, 0xF0, 0x1C }, 3, 0,
+      { PS2_KEY_A, PS2_BREAK | PS2_KEY_A }, 2 },
+    { "E0 extended", { 0xE0, 0x75 }, 2, 0,
+      { PS2_FUNCTION | PS2_KEY_UP_ARROW }, 1 },
+    { "E1 pause",   { 0xE1, 0x14, 0x77, 0xE1, 0xF0, 0x14, 0xF0, 0x77 }, 8, 0,
+      { PS2_FUNCTION | PS2_KEY_PAUSE }, 1 },
+    { "modifier",   { 0x12, 0x1C }, 2, 0,
+      { PS2_SHIFT | PS2_FUNCTION | PS2_KEY_L_SHIFT, PS2_SHIFT | PS2_KEY_A }, 2 },
+    { "parity error", { 0x1C }, 1, PARITY_ERROR,
+      { PS2_KEY_A }, 1 },
+    { "glitch",     { 0x1C }, 1, GLITCH,
+      { PS2_KEY_A }, 1 },
+};
+
+static int failures = 0;
+
+static uint32_t missed_edges = 0;   // Edges while the clock interrupt was masked
+static uint8_t sent[8];             // Bytes the driver sent, oldest first
+static uint8_t sent_count = 0;
+static uint8_t last_frame;          // Byte a RESEND asks for
+static bool_t keyboard_mute = false; // Keyboard takes commands but never answers
+
+static uint16_t handled_keys = 0;   // Keys seen by Handler()
+static int8_t cmd_status;           // Set by CommandDone()
+static bool_t cmd_done;
+
+/*=====[Implementations of private functions]================================*/
+
+static bool_t ClockIrqEnabled(void) {
+    return (NVIC->ISER[(uint32_t)PIN_INT0_IRQn >> 5] >> ((uint32_t)PIN_INT0_IRQn & 0x1F)) & 1;
+}
+
+/* One falling clock edge with the keyboard side of the data line at val */
+static void Edge(bool_t val) {
+    const pinInitGpioLpc4337_t *pin = &gpioPinsInit[DATA_PIN];
+
+    // Open collector: the line is low if either side pulls it low
+    LPC_GPIO_PORT->B[pin->gpio.port][pin->gpio.pin] = val && gpioRead(DATA_PIN);
+    if (!ClockIrqEnabled()) {
+        missed_edges++;  // A real edge would wait pending, none should come here
+        return;
+    }
+    LPC_GPIO_PIN_INT->FALL |= PININTCH(0);
+    GPIO0_IRQHandler();
+}
+
+static void Frame(uint8_t data, uint8_t faults);
+
+/* Clocks out the byte the driver started sending, as the keyboard does */
+static uint8_t ClockOut(void) {
+    uint8_t i, byte = 0, ones = 0;
+
+    for (i = 0; i < 8; i++) {  // Data bits, LSB first, sampled after each edge
+        Edge(1);
+        if (gpioRead(DATA_PIN)) {
+            byte |= 1 << i;
+            ones++;
+        }
+    }
+    Edge(1);
+    CHECK(((ones + gpioRead(DATA_PIN)) & 1) == 1);  // Odd parity
+    Edge(1);
+    CHECK(!hostGpioDriven(DATA_PIN));  // Stop bit: line released
+    Edge(0);  // Keyboard acknowledges
+
+    if (sent_count < sizeof(sent))
+        sent[sent_count++] = byte;
+    return byte;
+}
+
+/* Takes and answers whatever the driver sends */
+static void Keyboard(void) {
+    uint8_t cmd;
+
+    while (hostGpioDriven(DATA_PIN)) {
+        cmd = ClockOut();
+        if (keyboard_mute)
+            continue;
+        if (cmd == PS2_KC_RESEND)
+            Frame(last_frame, 0);
+        else
+            Frame(PS2_KC_ACK, 0);
+    }
+}
+
+/* Clocks one frame into the driver: start, data, parity and stop bits */
+static void Frame(uint8_t data, uint8_t faults) {
+    uint8_t i, bit, parity = 1;  // Odd parity: bit is 1 when data has an even count of ones
+
+    if (faults & GLITCH) {
+        // Noise edges start a bogus frame that never completes
+        Edge(0);
+        Edge(1);
+        Edge(0);
+        RIT_IRQHandler();  // Frame timeout re-syncs the receiver
+    }
+
+    last_frame = data;
+    Edge(0);
+    for (i = 0; i < 8; i++) {
+        bit = (data >> i) & 1;
+        parity ^= bit;
+        Edge(bit);
+    }
+    Edge((faults & PARITY_ERROR) ? !parity : parity);
+    Edge(1);
+    Keyboard();
+}
+
+static void Sequence(const uint8_t *codes, uint8_t len, uint8_t faults) {
+    uint8_t i;
+
+    for (i = 0; i < len; i++)
+        Frame(codes[i], i == 0 ? faults : 0);
+}
+
+static void Handler(uint16_t key) {
+    handled_keys++;
+}
+
+static void CommandDone(int8_t status, const uint8_t *resp, uint8_t len, void *ctx) {
+    cmd_status = status;
+    cmd_done = true;
+}
+
+static void test_scenarios(void) {
+    const simCase_t *tc;
+    uint16_t key;
+    uint8_t n;
+    bool_t ok;
+
+    for (tc = sim_cases; tc < sim_cases + sizeof(sim_cases) / sizeof(sim_cases[0]); tc++) {
+        PS2Keyboard_EnableInt();  // Resets the driver state
+        sent_count = 0;
+        Sequence(tc->codes, tc->len, tc->faults);
+
+        ok = true;
+        n = 0;
+        while ((key = PS2Keyboard_Read()) != 0) {
+            if (n >= tc->nkeys || key != tc->keys[n])
+                ok = false;
+            n++;
+        }
+        if (n != tc->nkeys)
+            ok = false;
+        if (tc->faults & PARITY_ERROR)
+            ok &= (sent_count == 1 && sent[0] == PS2_KC_RESEND);
+        else
+            ok &= (sent_count == 0);
+
+        printf("PS/2 sim: %-12s %s\n", tc->name, ok ? "PASS" : "FAIL");
+        if (!ok)
+            failures++;
+    }
+}
+
+/* Responses nobody asked for (BAT after a hot plug, ECHO) never reach handlers */
+static void test_responses_not_keys(void) {
+    PS2Keyboard_EnableInt();
+    PS2Keyboard_Subscribe(Handler, PS2_EVENT_ALL, 0);
+    handled_keys = 0;
+
+    Frame(PS2_KC_BAT, 0);
+    Frame(PS2_KC_ECHO, 0);
+    PS2Keyboard_Process();
+    CHECK(handled_keys == 0);
+
+    Frame(0x1C, 0);
+    PS2Keyboard_Process();
+    CHECK(handled_keys == 1);
+
+    PS2Keyboard_Unsubscribe(Handler);
+}
+
+/* A command sent before PS2Keyboard_EnableInt() was ever called */
+static void test_command_keeps_irq(void) {
+    ps2Command_t cmd = { .bytes = { PS2_KC_RATE, 0x2B }, .len = 2, .callback = CommandDone };
+    uint8_t i;
+
+    PS2Keyboard_Init(DATA_PIN, CLOCK_PIN);
+    sent_count = 0;
+    cmd_done = false;
+    CHECK(PS2Keyboard_SendCommand(&cmd) == 1);
+    for (i = 0; i < 10 && !cmd_done; i++) {
+        PS2Keyboard_Available();  // Feeds the command, collects the ACKs
+        Keyboard();
+    }
+    CHECK(cmd_done && cmd_status == PS2_CMD_OK);
+    CHECK(sent_count == 2 && sent[0] == PS2_KC_RATE && sent[1] == 0x2B);
+    CHECK(ClockIrqEnabled());
+}
+
+/* A command the keyboard never answers times out with the interrupt still on */
+static void test_command_timeout_keeps_irq(void) {
+    ps2Command_t cmd = { .bytes = { PS2_KC_ECHO }, .len = 1, .timeout_ms = 20,
+                         .callback = CommandDone };
+    uint8_t i;
+
+    PS2Keyboard_Init(DATA_PIN, CLOCK_PIN);
+    keyboard_mute = true;
+    cmd_done = false;
+    CHECK(PS2Keyboard_SendCommand(&cmd) == 1);
+    for (i = 0; i < 10 && !cmd_done; i++) {
+        PS2Keyboard_Available();
+        Keyboard();
+        hostAdvance(10);
+    }
+    keyboard_mute = false;
+    CHECK(cmd_done && cmd_status == PS2_CMD_TIMEOUT);
+    CHECK(ClockIrqEnabled());
+}
+
+/* Typematic burst: repeated make codes with nobody draining the queue */
+static void test_burst(void) {
+    ps2Stats_t stats;
+    uint8_t burst;
+
+    PS2Keyboard_EnableInt();
+    PS2Keyboard_ResetStats();
+    for (burst = 0; burst < 255; burst++) {
+        Frame(0x1C, 0);
+        PS2Keyboard_GetStats(&stats);
+        if (stats.rx_overflows)
+            break;
+    }
+    CHECK(stats.rx_overflows == 1);
+    // Fastest legal clock is 16.7 kHz, 60 us per bit and 11 bits per frame
+    printf("PS/2 sim: RX queue holds %u frames, drain at least every %u us\n",
+           stats.rx_high_water, stats.rx_high_water * 11 * 60);
+    while (PS2Keyboard_Read() != 0)
+        ;
+}
+
+/*=====[Main function, program entry point after power on or reset]==========*/
+
+int main(void) {
+    PS2Keyboard_Init(DATA_PIN, CLOCK_PIN);
+
+    test_scenarios();
+    test_responses_not_keys();
+    test_command_keeps_irq();
+    test_command_timeout_keeps_irq();
+    test_burst();
+    CHECK(missed_edges == 0);
+
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,176 @@
+/**
+ * @file test_ring_buffer.c
+ * @brief Host tests of the ring buffer: wrap-around, full/empty, statistics
+ * and a two-thread producer/consumer run.
+ *
+ * Build and run with `make` in this directory.
+ *
+ * @author
+ *   - Juan Bautista Iacobucci <link00222@gmail.com>
+ *   - Fernando Ramirez Tolentino <fernandoramireztolentino@hotmail.com>
+ *   - Lisandro Martinez <lisandromartz@gmail.com>
+ * @date 2025/03/10
+ *
+ * @copyright
+ * Released under the MIT License.
+ */
+
+/*=====[Inclusions of function dependencies]=================================*/
+
+#include <stdio.h>
+#include <pthread.h>
+#include "ring_buffer.h"
+
+/*=====[Definition macros of private constants]==============================*/
+
+#ifndef STRESS_COUNT
+#define STRESS_COUNT 100000UL  // Elements passed between the threads
+#endif
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            printf("%s:%d: %s\n", __FILE__, __LINE__, #cond); \
+            failures++; \
+        } \
+    } while (0)
+
+/*=====[Definitions of private global variables]=============================*/
+
+static int failures = 0;
+
+static uint16_t stress_data[128];
+static ringBuffer_t stress_rb = RING_BUFFER_INIT(stress_data);
+static unsigned long stress_errors = 0;
+
+/*=====[Implementations of private functions]================================*/
+
+static void test_empty_full(void) {
+    static uint16_t data[4];
+    ringBuffer_t rb = RING_BUFFER_INIT(data);
+    uint16_t v;
+    uint16_t i;
+
+    CHECK(RingBuffer_IsEmpty(&rb));
+    CHECK(!RingBuffer_IsFull(&rb));
+    CHECK(!RingBuffer_Pop(&rb, &v));
+    CHECK(!RingBuffer_Peek(&rb, 0, &v));
+
+    for (i = 0; i < 4; i++)
+        CHECK(RingBuffer_Push(&rb, 100 + i));  // Whole size usable
+    CHECK(RingBuffer_IsFull(&rb));
+    CHECK(RingBuffer_Count(&rb) == 4);
+    CHECK(RingBuffer_Peek(&rb, 3, &v) && v == 103);
+    CHECK(!RingBuffer_Peek(&rb, 4, &v));
+
+    for (i = 0; i < 4; i++)
+        CHECK(RingBuffer_Pop(&rb, &v) && v == 100 + i);
+    CHECK(RingBuffer_IsEmpty(&rb));
+    CHECK(!RingBuffer_Pop(&rb, NULL));
+}
+
+static void test_wrap_around(void) {
+    static uint16_t data[8];
+    ringBuffer_t rb = RING_BUFFER_INIT(data);
+    uint16_t v;
+    uint16_t i;
+
+    // Indexes are free running, move them up to the 8-bit limit
+    for (i = 0; i < 253; i++) {
+        RingBuffer_Push(&rb, i);
+        RingBuffer_Pop(&rb, NULL);
+    }
+    CHECK(rb.head == 253 && rb.tail == 253);
+
+    // Fill across 255 -> 0
+    for (i = 0; i < 8; i++)
+        CHECK(RingBuffer_Push(&rb, 1000 + i));
+    CHECK(rb.head == 5);
+    CHECK(RingBuffer_Count(&rb) == 8);
+    CHECK(RingBuffer_IsFull(&rb));
+    CHECK(!RingBuffer_Push(&rb, 0));
+    CHECK(RingBuffer_Peek(&rb, 7, &v) && v == 1007);
+
+    for (i = 0; i < 8; i++)
+        CHECK(RingBuffer_Pop(&rb, &v) && v == 1000 + i);
+    CHECK(rb.tail == 5);
+    CHECK(RingBuffer_IsEmpty(&rb));
+}
+
+static void test_stats(void) {
+    static uint16_t data[2];
+    ringBuffer_t rb = RING_BUFFER_INIT(data);
+
+    CHECK(RingBuffer_Push(&rb, 1));
+    CHECK(rb.high_water == 1);
+    CHECK(RingBuffer_Push(&rb, 2));
+    CHECK(!RingBuffer_Push(&rb, 3));
+    CHECK(!RingBuffer_Push(&rb, 4));
+    CHECK(rb.overflows == 2);
+    CHECK(rb.high_water == 2);
+
+    // Reset keeps the statistics, ClearStats drops them
+    RingBuffer_Reset(&rb);
+    CHECK(RingBuffer_IsEmpty(&rb));
+    CHECK(rb.overflows == 2 && rb.high_water == 2);
+    RingBuffer_ClearStats(&rb);
+    CHECK(rb.overflows == 0 && rb.high_water == 0);
+
+    // The rejected elements did not replace stored ones
+    CHECK(RingBuffer_Push(&rb, 5));
+    CHECK(RingBuffer_Push(&rb, 6));
+    CHECK(!RingBuffer_Push(&rb, 7));
+    CHECK(RingBuffer_Pop(&rb, NULL));
+    CHECK(RingBuffer_Push(&rb, 8));
+    CHECK(rb.data[0] == 8 && rb.data[1] == 6);
+}
+
+static void *stress_producer(void *arg) {
+    unsigned long i;
+
+    for (i = 0; i < STRESS_COUNT; ) {
+        if (RingBuffer_Push(&stress_rb, (uint16_t)i))
+            i++;
+    }
+    return arg;
+}
+
+static void *stress_consumer(void *arg) {
+    unsigned long i;
+    uint16_t v;
+
+    for (i = 0; i < STRESS_COUNT; ) {
+        if (RingBuffer_Pop(&stress_rb, &v)) {
+            if (v != (uint16_t)i)
+                stress_errors++;  // Lost, repeated or torn element
+            i++;
+        }
+    }
+    return arg;
+}
+
+static void test_two_threads(void) {
+    pthread_t producer, consumer;
+
+    CHECK(pthread_create(&consumer, NULL, stress_consumer, NULL) == 0);
+    CHECK(pthread_create(&producer, NULL, stress_producer, NULL) == 0);
+    pthread_join(producer, NULL);
+    pthread_join(consumer, NULL);
+
+    CHECK(stress_errors == 0);
+    CHECK(RingBuffer_IsEmpty(&stress_rb));
+    printf("two threads: %lu elements, %lu out of sequence, %u full pushes, high water %u\n",
+           STRESS_COUNT, stress_errors, stress_rb.overflows, stress_rb.high_water);
+}
+
+/*=====[Main function, program entry point after power on or reset]==========*/
+
+int main(void) {
+    test_empty_full();
+    test_wrap_around();
+    test_stats();
+    test_two_threads();
+
+    printf("%s\n", failures ? "FAILED" : "OK");
+    return failures ? 1 : 0;
+}
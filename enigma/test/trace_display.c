@@ -0,0 +1,90 @@
+/**
+ * @file trace_display.c
+ * @brief Host run of the scrolling text through led_matrix, max7219 and
+ * spi_generic_device, with the SPI HAL stubbed (host/host_spi.c).
+ *
+ * Built with MAX7219_TRACE: the display rebuilt from the decoded bus
+ * traffic is written as a PPM image each time a frame goes out, then the
+ * trace and display statistics are printed, with how often the PS/2
+ * interrupts were masked. Run with `make trace`.
+ *
+ * Usage: trace_display [output directory] [text]
+ *
+ * @copyright
+ * Released under the MIT License.
+ */
+
+/*=====[Inclusions of function dependencies]=================================*/
+
+#include <stdio.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include "sapi.h"
+#include "animation.h"
+#include "max7219.h"
+
+/*=====[Definition macros of private constants]==============================*/
+
+#define RUN_MS 20000    // Gives up if the text has not gone by
+
+/*=====[Implementations of private functions]================================*/
+
+// Max7219TracePpm() prints to stdout, point it to the file for a moment
+static bool_t WritePpm(const char *dir, uint32_t n) {
+    char name[256];
+    int fd, out;
+
+    snprintf(name, sizeof(name), "%s/frame_%04lu.ppm", dir, (unsigned long)n);
+    fd = open(name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        perror(name);
+        return false;
+    }
+    fflush(stdout);
+    out = dup(STDOUT_FILENO);
+    dup2(fd, STDOUT_FILENO);
+    close(fd);
+    Max7219TracePpm();
+    fflush(stdout);
+    dup2(out, STDOUT_FILENO);
+    close(out);
+    return true;
+}
+
+/*=====[Main function, program entry point after power on or reset]==========*/
+
+int main(int argc, char **argv) {
+    const char *dir = (argc > 1) ? argv[1] : ".";
+    char *text = (argc > 2) ? argv[2] : "ENIGMA ";
+    uint32_t frames, images = 0;
+    spiBusStats_t bus;
+    tick_t ms;
+    bool_t done = false;
+
+    Animation_Init();  // Init sequence counted as control bytes
+    Animation_ResetStats();
+
+    frames = hostFrames();
+    for (ms = 0; ms < RUN_MS && !done; ms++) {
+        done = Animation_ShiftText(text, ms == 0);
+        if (hostFrames() != frames) {
+            frames = hostFrames();
+            if (!WritePpm(dir, images++))
+                return 1;
+        }
+        hostAdvance(1);
+    }
+
+    printf("%lu images in %s, %lu ms\n", (unsigned long)images, dir, (unsigned long)ms);
+    Max7219TraceRender();
+    Max7219TraceReport();
+    Animation_PrintStats();
+
+    // PS/2 interrupts masked by the display code, and the longest bus hold,
+    // which is how long a registered pin interrupt was masked before the lease
+    SpiDevGetStats(max7219_spi_default_cfg.ssp, &bus);
+    printf("PS/2: PIN_INT0 masked %lu times, RIT %lu, longest SPI lease %lu us\n",
+           (unsigned long)host_nvic_masks[PIN_INT0_IRQn], (unsigned long)host_nvic_masks[RITIMER_IRQn],
+           (unsigned long)bus.hold_us_max);
+    return done ? 0 : 1;
+}
@@ -52,10 +52,11 @@
 #define PS2_KEY_IGNORE  0xBB
 
 //  buffer sizes keyboard RX and TX, then key reading buffer
+//  all are ring_buffer queues so sizes MUST be powers of two
 // Minimum size 8 can be larger
 #define _RX_BUFFER_SIZE  8
 // Minimum size 6 can be larger
-#define _TX_BUFFER_SIZE  6
+#define _TX_BUFFER_SIZE  8
 // Output Buffer of unsigned int values. Minimum size 4 can be larger
 #define _KEY_BUFF_SIZE   4
 
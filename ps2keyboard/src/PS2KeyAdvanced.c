@@ -137,6 +137,7 @@
 #include "PS2KeyAdvanced.h"
 #include "PS2KeyCode.h"
 #include "PS2KeyTable.h"
+#include "ring_buffer.h"
 
 extern pinInitGpioLpc4337_t gpioPinsInit[];
 
@@ -144,6 +145,7 @@ extern pinInitGpioLpc4337_t gpioPinsInit[];
 void send_bit(void);
 void send_now(uint8_t);
 int16_t send_next(void);
+void send_pending(void);
 void ps2_reset(void);
 uint8_t decode_key(uint8_t);
 //void pininput(uint8_t);
@@ -171,18 +173,16 @@ volatile uint8_t _ps2mode; /* _ps2mode contains
  and not sent anything */
 
 /* volatile RX buffers and variables accessed via interrupt functions */
-volatile uint16_t _rx_buffer[_RX_BUFFER_SIZE];  // buffer for data from keyboard
-volatile uint8_t _head;              // _head = last byte written
-uint8_t _tail;              // _tail = last byte read (not modified in IRQ ever)
+uint16_t _rx_data[_RX_BUFFER_SIZE];  // buffer for data from keyboard
+ringBuffer_t _rx_buffer = RING_BUFFER_INIT(_rx_data); // pushed in IRQ, popped by translate
 volatile int8_t _bytes_expected;
 volatile uint8_t _bitcount;  // Main state variable and bit count for interrupts
 volatile uint8_t _shiftdata;
 volatile uint8_t _parity;
 
 /* TX variables */
-volatile uint8_t _tx_buff[_TX_BUFFER_SIZE];    // buffer for keyboard commands
-volatile uint8_t _tx_head;          // buffer write pointer
-volatile uint8_t _tx_tail;          // buffer read pointer
+uint16_t _tx_data[_TX_BUFFER_SIZE];    // buffer for keyboard commands
+ringBuffer_t _tx_buff = RING_BUFFER_INIT(_tx_data); // popped in IRQ and by send_pending
 volatile uint8_t _last_sent;        // last byte if resend requested
 volatile uint8_t _now_send;         // immediate byte to send
 volatile uint8_t _response_count;   // bytes expected in reply to next TX
@@ -191,9 +191,8 @@ volatile uint8_t _tx_ready;         // TX status for type of send contains
  _COMMAND   0x01 = other command processing */
 
 /* Output key buffering */
-uint16_t _key_buffer[_KEY_BUFF_SIZE]; // Output Buffer for translated keys
-uint8_t _key_head;                      // Output buffer WR pointer
-uint8_t _key_tail;                      // Output buffer RD pointer
+uint16_t _key_data[_KEY_BUFF_SIZE]; // Output Buffer for translated keys
+ringBuffer_t _key_buffer = RING_BUFFER_INIT(_key_data);
 uint8_t _mode = 0;            // Mode for output buffer contains
 /* _NO_REPEATS 0x80 No repeat make codes for _CTRL, _ALT, _SHIFT, _GUI
  _NO_BREAKS  0x08 No break codes */
@@ -260,6 +259,7 @@ void GPIO0_IRQHandler(void) {
 					_parity = 0xFD; // To ensure at next bit count clear and discard
 				break;
 			case 11: // Stop bit, lots of spare time now
+				_bitcount = 0;	            // end of byte, before send_now sets it
 				if (_parity >= 0xFD)    // had parity error
 				{
 					send_now(PS2_KC_RESEND);    // request resend
@@ -273,16 +273,8 @@ void GPIO0_IRQHandler(void) {
 						_bytes_expected--;
 					if (_bytes_expected <= 0 || (ret & 4))   // Save value ??
 					{
-						val = _head + 1;
-						if (val >= _RX_BUFFER_SIZE)
-							val = 0;
-						if (val != _tail) {
-							// get last byte to save
-							_rx_buffer[val] = (uint16_t) _shiftdata;
-							// save extra details
-							_rx_buffer[val] |= ((uint16_t) _ps2mode) << 8;
-							_head = val;
-						}
+						// save last byte with extra details
+						RingBuffer_Push(&_rx_buffer, (uint16_t) _shiftdata | ((uint16_t) _ps2mode) << 8);
 					}
 					if (ret & 0x10)         // Special command to send (ECHO/RESEND)
 					{
@@ -298,7 +290,6 @@ void GPIO0_IRQHandler(void) {
 						send_next();              // Check for more to send
 					}
 				}
-				_bitcount = 0;	            // end of byte
 				break;
 			default: // in case of weird error and end of byte reception re-sync
 				_bitcount = 0;
@@ -523,13 +514,10 @@ void send_now(uint8_t command) {
 
  Note PS2_KEY_IGNORE is used to denote a byte(s) expected in response */
 int16_t send_next(void) {
-	uint8_t i;
-	int16_t val;
+	uint16_t val, next;
 
-	val = -1;
 	// Check buffer not empty
-	i = _tx_tail;
-	if (i == _tx_head)
+	if (RingBuffer_IsEmpty(&_tx_buff))
 		return -2;
 
 	// set command bit in _tx_ready as another command to do
@@ -545,24 +533,31 @@ int16_t send_next(void) {
 
 	// Following only accessed when not receiving or sending protocol bytes
 	// Scan for command response and expected bytes to follow
+	RingBuffer_Pop(&_tx_buff, &val);
 	_response_count = 0;
-	do {
-		i++;
-		if (i >= _TX_BUFFER_SIZE)
-			i = 0;
-		if (val == -1)
-			val = _tx_buff[i];
-		else if (_tx_buff[i] != PS2_KEY_IGNORE)
-			break;
-		else
-			_response_count++;
-		_tx_tail = i;
-	} while (i != _tx_head);
+	while (RingBuffer_Peek(&_tx_buff, 0, &next) && next == PS2_KEY_IGNORE) {
+		RingBuffer_Pop(&_tx_buff, NULL);
+		_response_count++;
+	}
 	// Now know what to send and expect start the actual wire sending
-	send_now(val);
+	send_now((uint8_t) val);
 	return 1;
 }
 
+/*  Start the next transmission from the main loop
+ send_next is also called by the clock interrupt, the other consumer of
+ _tx_buff, so the interrupt is held off while it runs; it is only enabled
+ again if it was (NVIC ISER reads back the enable bits) */
+void send_pending(void) {
+	uint32_t enabled = NVIC->ISER[(uint32_t) PIN_INT0_IRQn >> 5]
+			& (1UL << ((uint32_t) PIN_INT0_IRQn & 0x1F));
+
+	NVIC_DisableIRQ(PIN_INT0_IRQn);
+	send_next();
+	if (enabled)
+		NVIC_EnableIRQ(PIN_INT0_IRQn);
+}
+
 /*  Send a byte to the TX buffer
  Value in buffer of PS2_KEY_IGNORE signifies wait for response,
  use one for each byte expected
@@ -570,27 +565,17 @@ int16_t send_next(void) {
  Returns -4 - if buffer full (buffer overrun not written)
  Returns 1 byte written when done */
 int send_byte(uint8_t val) {
-	uint8_t ret;
-
-	ret = _tx_head + 1;
-	if (ret >= _TX_BUFFER_SIZE)
-		ret = 0;
-	if (ret != _tx_tail) {
-		_tx_buff[ret] = val;
-		_tx_head = ret;
+	if (RingBuffer_Push(&_tx_buff, val))
 		return 1;
-	}
 	return -4;
 }
 
 void ps2_reset(void) {
 	/* reset buffers and states */
-	_tx_head = 0;
-	_tx_tail = 0;
+	RingBuffer_Reset(&_tx_buff);
 	_tx_ready = 0;
 	_response_count = 0;
-	_head = 0;
-	_tail = 0;
+	RingBuffer_Reset(&_rx_buffer);
 	_bitcount = 0;
 	PS2_keystatus = 0;
 	PS2_led_lock = 0;
@@ -598,12 +583,7 @@ void ps2_reset(void) {
 }
 
 uint8_t key_available() {
-	int8_t i;
-
-	i = _head - _tail;
-	if (i < 0)
-		i += _RX_BUFFER_SIZE;
-	return (uint8_t) i;
+	return RingBuffer_Count(&_rx_buffer);
 }
 
 /*  Translate PS2 keyboard code sequence into our key code data
@@ -617,25 +597,18 @@ uint8_t key_available() {
  */
 uint16_t translate(void) {
 	uint8_t index, length, data;
-	uint16_t retdata;
+	uint16_t retdata, entry;
 
-	// get next character
-	// Check first something to fetch
-	index = _tail;
-	// check for empty buffer
-	if (index == _head)
+	// get next character, 0 for empty buffer
+	if (!RingBuffer_Pop(&_rx_buffer, &entry))
 		return 0;
-	index++;
-	if (index >= _RX_BUFFER_SIZE)
-		index = 0;
-	_tail = index;
 	// Get the flags byte break modes etc in this order
-	data = _rx_buffer[index] & 0xFF;
-	index = (_rx_buffer[index] & 0xFF00) >> 8;
+	data = entry & 0xFF;
+	index = (entry & 0xFF00) >> 8;
 
 	// Catch special case of PAUSE key
 	if (index & _E1_MODE)
-		return PS2_KEY_PAUSE + _FUNCTION;
+		return PS2_FUNCTION | PS2_KEY_PAUSE;
 
 	// Ignore anything not actual keycode but command/response
 	// Return untranslated as valid
@@ -761,7 +734,7 @@ void set_lock() {
 	send_byte(PS2_KEY_IGNORE);     // wait ACK
 	send_byte(PS2_led_lock);       // send data from internal variable
 	if ((send_byte(PS2_KEY_IGNORE))) // wait ACK
-		send_next();              // if idle start transmission
+		send_pending();           // if idle start transmission
 }
 
 /*  Send echo command to keyboard
@@ -769,7 +742,7 @@ void set_lock() {
 void PS2KeyAdvanced_echo(void) {
 	send_byte(PS2_KC_ECHO);             // send command
 	if ((send_byte( PS2_KEY_IGNORE))) // wait data PS2_KC_ECHO
-		send_next();                   // if idle start transmission
+		send_pending();                // if idle start transmission
 }
 
 /*  Get the ID used in keyboard
@@ -779,7 +752,7 @@ void PS2KeyAdvanced_readID(void) {
 	send_byte( PS2_KEY_IGNORE);          // wait ACK
 	send_byte( PS2_KEY_IGNORE);          // wait data
 	if ((send_byte( PS2_KEY_IGNORE))) // wait data
-		send_next();                   // if idle start transmission
+		send_pending();                // if idle start transmission
 }
 
 /*  Get the current Scancode Set used in keyboard
@@ -790,7 +763,7 @@ void PS2KeyAdvanced_getScanCodeSet(void) {
 	send_byte(0);                       // send data 0 = read
 	send_byte( PS2_KEY_IGNORE);          // wait ACK
 	if ((send_byte( PS2_KEY_IGNORE))) // wait data
-		send_next();                   // if idle start transmission
+		send_pending();                // if idle start transmission
 }
 
 /* Returns the current status of Locks */
@@ -829,7 +802,7 @@ void PS2KeyAdvanced_resetKey() {
 	send_byte( PS2_KC_RESET);            // send command
 	send_byte( PS2_KEY_IGNORE);          // wait ACK
 	if ((send_byte( PS2_KEY_IGNORE))) // wait data PS2_KC_BAT or PS2_KC_ERROR
-		send_next();                        // if idle start transmission
+		send_pending();                     // if idle start transmission
 	// LEDs and KeyStatus Reset too... to match keyboard
 	PS2_led_lock = 0;
 	PS2_keystatus = 0;
@@ -854,7 +827,7 @@ int PS2KeyAdvanced_typematic(uint8_t rate, uint8_t delay) {
 	send_byte( PS2_KEY_IGNORE);          // wait ACK
 	send_byte((delay << 5) + rate);   // Send values
 	if ((send_byte( PS2_KEY_IGNORE))) // wait ACK
-		send_next();                   // if idle start transmission
+		send_pending();                // if idle start transmission
 	return 0;
 }
 
@@ -867,54 +840,31 @@ int PS2KeyAdvanced_typematic(uint8_t rate, uint8_t delay) {
  returns actual count
 
  Returns   0 buffer empty
- 1 to buffer size less 1 as 1 to full buffer
-
- As with other ring buffers here when pointers match
- buffer empty so cannot actually hold buffer size values  */
+ 1 to buffer size as 1 to full buffer  */
 uint8_t PS2KeyAdvanced_available() {
-	int8_t i, idx;
 	uint16_t data;
 
-	// check output queue
-	i = _key_head - _key_tail;
-	if (i < 0)
-		i += _KEY_BUFF_SIZE;
-	while (i < ( _KEY_BUFF_SIZE - 1)) // process if not full
+	while (!RingBuffer_IsFull(&_key_buffer)) // process if not full
 		if (key_available())         // not check for more keys to process
 		{
 			data = translate();         // get next translated key
 			if (data == 0)             // unless in buffer is empty
 				break;
-			if ((data & 0xFF) != PS2_KEY_IGNORE && (data & 0xFF) > 0) {
-				idx = _key_head + 1;         // point to next space
-				if (idx >= _KEY_BUFF_SIZE)  // loop to front if necessary
-					idx = 0;
-				_key_buffer[idx] = data; // save the data to out buffer
-				_key_head = idx;
-				i++;                      // update count
-			}
+			if ((data & 0xFF) != PS2_KEY_IGNORE && (data & 0xFF) > 0)
+				RingBuffer_Push(&_key_buffer, data); // save the data to out buffer
 		} else
 			break;                      // exit nothing coming in
-	return (uint8_t) i;
+	return RingBuffer_Count(&_key_buffer);
 }
 
 /* read a decoded key from the keyboard buffer
  returns 0 for empty buffer */
 uint16_t PS2KeyAdvanced_read( )
 {
-	uint16_t result;
-	uint8_t idx;
+	uint16_t result = 0;
 
-	result = PS2KeyAdvanced_available();
-	if( result )
-	{
-		idx = _key_tail;
-		idx++;
-		if( idx >= _KEY_BUFF_SIZE )  // loop to front if necessary
-		idx = 0;
-		_key_tail = idx;
-		result = _key_buffer[ idx ];
-	}
+	if( PS2KeyAdvanced_available() )
+		RingBuffer_Pop( &_key_buffer, &result );
 	return result;
 }
 